@@ -0,0 +1,72 @@
+#include "ChunkStore.h"
+#include "ChunkHash.h"
+
+#include <iostream> // std::cerr
+
+// ================================================================
+//  AddFile: 로컬 파일을 CDC 로 잘라 청크 위치를 색인
+// ================================================================
+bool ChunkStore::AddFile(const std::string& filePath)
+{
+    auto file = std::make_unique<std::ifstream>(filePath, std::ios::binary);
+    if (!*file) {
+        std::cerr << "[ChunkStore] Failed to open file: " << filePath << "\n";
+        return false;
+    }
+
+    // 송신 측과 같은 파라미터로 잘라야 같은 경계가 나온다
+    FileSplitterAndMerger fsm;
+    auto packets = fsm.SplitFileContentDefined(filePath);
+
+    uint32_t fileIndex = static_cast<uint32_t>(m_files.size());
+    uint64_t offset = 0;
+    for (const auto& p : packets) {
+        uint64_t hash = ChunkHash64(p.data.data(), p.length);
+        m_index.emplace(hash, Location{fileIndex, offset, p.length});
+        offset += p.length;
+    }
+
+    m_files.push_back(std::move(file));
+    return true;
+}
+
+// ================================================================
+//  Find: 색인된 위치에서 청크를 읽고 해시로 한 번 더 확인
+// ================================================================
+bool ChunkStore::Find(const ChunkManifestEntry& entry, std::string& out)
+{
+    auto it = m_index.find(entry.hash);
+    if (it == m_index.end() || it->second.length != entry.length)
+        return false;
+
+    std::ifstream& in = *m_files[it->second.fileIndex];
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(it->second.offset));
+
+    out.resize(entry.length);
+    in.read(out.data(), static_cast<std::streamsize>(entry.length));
+    if (in.gcount() != static_cast<std::streamsize>(entry.length))
+        return false;
+
+    // 색인 이후 로컬 파일이 바뀌었을 수도 있으므로 내용 확인
+    return ChunkHash64(out.data(), out.size()) == entry.hash;
+}
+
+// ================================================================
+//  FindHaveRanges: 매니페스트에서 이미 가진 청크 번호 구간
+// ================================================================
+std::vector<PacketRange> ChunkStore::FindHaveRanges(const std::vector<ChunkManifestEntry>& manifest) const
+{
+    std::vector<PacketRange> ranges;
+    for (uint64_t i = 0; i < manifest.size(); ++i) {
+        auto it = m_index.find(manifest[i].hash);
+        if (it == m_index.end() || it->second.length != manifest[i].length)
+            continue;
+
+        if (!ranges.empty() && ranges.back().end == i)
+            ranges.back().end = i + 1;
+        else
+            ranges.push_back({i, i + 1});
+    }
+    return ranges;
+}
@@ -0,0 +1,61 @@
+#ifndef CHUNK_STORE_H
+#define CHUNK_STORE_H
+
+#include "FileSplitterAndMerger.h"
+#include "PacketRange.h"
+
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief 수신 측이 이미 가지고 있는 청크들의 색인
+ *
+ * - 이전 버전 파일 등 로컬 파일을 내용 기반(CDC)으로 잘라 hash -> 파일 위치로 기억한다.
+ * - 송신 측이 보낸 매니페스트(FILE_MANIFEST)와 비교해서 이미 있는 청크 번호를
+ *   FILE_HAVE 로 돌려주면, 나머지 청크만 UDP 로 전송된다.
+ */
+class ChunkStore {
+public:
+    /**
+     * @brief 로컬 파일을 색인에 추가한다.
+     *
+     * @param filePath  색인할 파일 (보통 같은 파일의 이전 버전)
+     * @return 성공 시 true
+     */
+    bool AddFile(const std::string& filePath);
+
+    /**
+     * @brief hash/length 가 같은 청크를 로컬 파일에서 읽어온다.
+     *
+     * @param entry  매니페스트 항목
+     * @param out    읽은 청크 데이터 (출력 매개변수)
+     * @return 찾아서 읽었으면 true (읽은 내용의 해시까지 다시 확인)
+     */
+    bool Find(const ChunkManifestEntry& entry, std::string& out);
+
+    /**
+     * @brief 매니페스트 중 로컬에 이미 있는 청크 번호 구간 목록
+     */
+    std::vector<PacketRange> FindHaveRanges(const std::vector<ChunkManifestEntry>& manifest) const;
+
+    /**
+     * @brief 색인된 청크 수
+     */
+    std::size_t Size() const { return m_index.size(); }
+
+private:
+    struct Location {
+        uint32_t fileIndex;
+        uint64_t offset;
+        uint32_t length;
+    };
+
+    // 색인된 파일들 (Find 에서 읽기용으로 열어 둔다)
+    std::vector<std::unique_ptr<std::ifstream>> m_files;
+
+    // key: 청크 해시
+    std::unordered_map<uint64_t, Location> m_index;
+};
+
+#endif // CHUNK_STORE_H
@@ -1,9 +1,223 @@
 #include "FileSplitterAndMerger.h"
+#include "Crc32c.h"
+#include "Fec.h"
+#include "Lz.h"
+#include "ZeroRange.h"
+#include "ChunkHash.h"
+#include "Trace.h"
 
 #include <fstream>   // ifstream, ofstream (파일 입출력)
 #include <algorithm> // std::sort
 #include <iostream>  // std::cerr, std::cout
 #include <sstream>   // std::ostringstream
+#include <filesystem> // resize_file
+#include <array>     // Gear 테이블
+#include <cctype>    // isalnum, isxdigit
+#include <cstring>   // memmove
+#include <thread>    // MergeDirectory 쓰기 스레드
+#include <atomic>
+
+#include <cerrno>     // errno, ENXIO
+#include <fcntl.h>    // open
+#include <unistd.h>   // lseek, close
+#include <sys/stat.h> // fstat
+
+namespace {
+
+// ================================================================
+//  희소 파일 구멍 탐지 (SEEK_DATA / SEEK_HOLE)
+//  앞에서부터 순서대로 물어본다는 가정으로 현재 데이터 구간만 기억한다.
+// ================================================================
+class HoleMap {
+public:
+    explicit HoleMap(const std::string& filePath)
+        : m_fd(open(filePath.c_str(), O_RDONLY))
+    {
+        struct stat st{};
+        if (m_fd >= 0 && fstat(m_fd, &st) == 0)
+            m_fileSize = static_cast<uint64_t>(st.st_size);
+    }
+
+    ~HoleMap()
+    {
+        if (m_fd >= 0)
+            close(m_fd);
+    }
+
+    /**
+     * @brief pos 부터의 청크가 통째로 구멍이면 그 청크 길이, 아니면 0
+     */
+    std::size_t HoleChunkLength(uint64_t pos, std::size_t payloadSize)
+    {
+        if (m_fd < 0 || pos >= m_fileSize)
+            return 0;
+
+        uint64_t chunkEnd = std::min<uint64_t>(pos + payloadSize, m_fileSize);
+
+        // 현재 데이터 구간을 지나쳤으면 다음 데이터 구간을 찾는다
+        if (pos >= m_dataEnd) {
+            off_t begin = lseek(m_fd, static_cast<off_t>(pos), SEEK_DATA);
+            if (begin < 0 && errno == ENXIO) {
+                // pos 이후 파일 끝까지 구멍
+                m_dataBegin = m_dataEnd = m_fileSize;
+            } else if (begin < 0) {
+                // SEEK_DATA 미지원 파일시스템: 전부 데이터로 취급 (0 검사로만 판단)
+                m_dataBegin = 0;
+                m_dataEnd   = m_fileSize;
+            } else {
+                off_t end = lseek(m_fd, begin, SEEK_HOLE);
+                m_dataBegin = static_cast<uint64_t>(begin);
+                m_dataEnd   = (end < 0) ? m_fileSize : static_cast<uint64_t>(end);
+            }
+        }
+
+        bool overlapsData = pos < m_dataEnd && m_dataBegin < chunkEnd;
+        return overlapsData ? 0 : static_cast<std::size_t>(chunkEnd - pos);
+    }
+
+private:
+    int m_fd;
+    uint64_t m_fileSize = 0;
+    uint64_t m_dataBegin = 0;
+    uint64_t m_dataEnd = 0;
+};
+
+// ================================================================
+//  Gear 롤링 해시 테이블 (바이트 값마다 고정된 64비트 난수, splitmix64 로 생성)
+// ================================================================
+constexpr std::array<uint64_t, 256> MakeGearTable()
+{
+    std::array<uint64_t, 256> table{};
+    uint64_t x = 0x2545F4914F6CDD1Dull;
+    for (auto& v : table) {
+        x += 0x9E3779B97F4A7C15ull;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        v = z ^ (z >> 31);
+    }
+    return table;
+}
+
+constexpr std::array<uint64_t, 256> kGear = MakeGearTable();
+
+// 상위 bits 개 비트가 켜진 마스크 (Gear 해시는 상위 비트가 최근 64바이트 전체를 반영)
+constexpr uint64_t TopBitsMask(int bits)
+{
+    return bits <= 0 ? 0 : (~0ull << (64 - bits));
+}
+
+/**
+ * @brief data[0, length) 에서 첫 번째 자를 위치(청크 길이)를 찾는다.
+ */
+std::size_t FindCutPoint(const unsigned char* data, std::size_t length,
+                         std::size_t minSize, std::size_t avgSize, std::size_t maxSize,
+                         uint64_t maskHard, uint64_t maskEasy)
+{
+    if (length <= minSize)
+        return length;
+
+    std::size_t limit  = std::min(length, maxSize);
+    std::size_t normal = std::min(limit, avgSize);
+    uint64_t fp = 0;
+
+    std::size_t i = minSize;
+    for (; i < normal; ++i) {
+        fp = (fp << 1) + kGear[data[i]];
+        if (!(fp & maskHard))
+            return i + 1;
+    }
+    for (; i < limit; ++i) {
+        fp = (fp << 1) + kGear[data[i]];
+        if (!(fp & maskEasy))
+            return i + 1;
+    }
+    return limit;
+}
+
+// length 바이트가 전부 0인 청크를 나타내는 Packet
+Packet MakeZeroPacket(uint32_t seq, uint32_t length)
+{
+    Packet p;
+    p.seq      = seq;
+    p.data     = EncodeZeroRange({1, length, length});
+    p.length   = static_cast<uint32_t>(p.data.size());
+    p.checksum = Crc32c(p.data.data(), p.data.size());
+    p.flags    = PACKET_FLAG_ZERO;
+    return p;
+}
+
+/**
+ * @brief Packet 의 원본 데이터 위치를 얻는다.
+ *
+ * @param scratch  압축 Packet 을 풀 때 쓰는 버퍼
+ * @param data     원본 데이터 시작 (0 청크면 nullptr)
+ * @param length   원본 데이터 길이
+ * @return 형식 오류 시 false
+ */
+bool PacketRawView(const Packet& p, std::vector<unsigned char>& scratch,
+                   const char*& data, std::size_t& length)
+{
+    const auto* src = reinterpret_cast<const unsigned char*>(p.data.data());
+
+    if (p.flags & PACKET_FLAG_ZERO) {
+        data   = nullptr;
+        length = FileSplitterAndMerger::RawLength(p);
+        return length > 0;
+    }
+
+    if (p.flags & PACKET_FLAG_COMPRESSED) {
+        uint32_t rawLength = 0;
+        if (!LzReadRawLength(src, p.data.size(), rawLength))
+            return false;
+        scratch.resize(rawLength);
+        if (!LzDecompress(src, p.data.size(), scratch.data(), scratch.size()))
+            return false;
+        data   = reinterpret_cast<const char*>(scratch.data());
+        length = rawLength;
+        return true;
+    }
+
+    data   = p.data.data();
+    length = p.length;
+    return true;
+}
+
+// 경로 이스케이프 (인덱스 구분자 ',' ';' 와 공백, '%' 등)
+std::string EscapePath(const std::string& path)
+{
+    static const char* hex = "0123456789ABCDEF";
+    std::string out;
+    for (unsigned char c : path) {
+        if (std::isalnum(c) || c == '.' || c == '_' || c == '-' || c == '/') {
+            out.push_back(static_cast<char>(c));
+        } else {
+            out.push_back('%');
+            out.push_back(hex[c >> 4]);
+            out.push_back(hex[c & 0x0F]);
+        }
+    }
+    return out;
+}
+
+bool UnescapePath(const std::string& text, std::string& out)
+{
+    out.clear();
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '%') {
+            out.push_back(text[i]);
+            continue;
+        }
+        if (i + 2 >= text.size() || !std::isxdigit(static_cast<unsigned char>(text[i + 1]))
+                                 || !std::isxdigit(static_cast<unsigned char>(text[i + 2])))
+            return false;
+        out.push_back(static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16)));
+        i += 2;
+    }
+    return true;
+}
+
+} // namespace
 
 // ================================================================
 //  SplitFile 구현: 파일 -> Packet 벡터
@@ -11,6 +225,8 @@
 std::vector<Packet> FileSplitterAndMerger::SplitFile(const std::string& filePath,
                                                      std::size_t payloadSize)
 {
+    TRACE_SCOPE("SplitFile", payloadSize);
+
     std::vector<Packet> packets; // 결과를 담을 벡터
 
     // 1) payloadSize 유효성 체크
@@ -31,9 +247,21 @@ std::vector<Packet> FileSplitterAndMerger::SplitFile(const std::string& filePath
     // 3) payloadSize 크기만큼 읽어올 임시 버퍼
     std::vector<char> buffer(payloadSize);
     uint32_t seq = 0; // 패킷 번호 (0부터 시작)
+    uint64_t pos = 0; // 현재 파일 위치
+
+    // 희소 파일이면 구멍 구간은 읽지 않고 건너뛴다
+    HoleMap holes(filePath);
 
     // 4) 파일 끝까지 반복해서 읽으면서 Packet 생성
     while (in) {
+        std::size_t holeLength = holes.HoleChunkLength(pos, payloadSize);
+        if (holeLength > 0) {
+            pos += holeLength;
+            in.seekg(static_cast<std::streamoff>(pos));
+            packets.push_back(MakeZeroPacket(seq++, static_cast<uint32_t>(holeLength)));
+            continue;
+        }
+
         // 최대 payloadSize 바이트까지 읽기
         in.read(buffer.data(), static_cast<std::streamsize>(payloadSize));
         std::streamsize bytesRead = in.gcount(); // 실제로 읽힌 바이트 수
@@ -42,6 +270,13 @@ std::vector<Packet> FileSplitterAndMerger::SplitFile(const std::string& filePath
             // 더 이상 읽을 데이터가 없으면 루프 종료
             break;
         }
+        pos += static_cast<uint64_t>(bytesRead);
+
+        // 전부 0인 청크는 데이터 대신 구간 표식으로
+        if (IsAllZero(buffer.data(), static_cast<std::size_t>(bytesRead))) {
+            packets.push_back(MakeZeroPacket(seq++, static_cast<uint32_t>(bytesRead)));
+            continue;
+        }
 
         // 5) Packet 하나 생성
         Packet p;
@@ -52,6 +287,9 @@ std::vector<Packet> FileSplitterAndMerger::SplitFile(const std::string& filePath
         p.data.assign(buffer.data(),
                       buffer.data() + static_cast<std::size_t>(bytesRead));
 
+        // 무결성 검사용 CRC32C (데이터그램 체크섬 계산에 재사용)
+        p.checksum = Crc32c(p.data.data(), p.data.size());
+
         // 6) 결과 벡터에 추가
         packets.push_back(std::move(p));
     }
@@ -89,20 +327,55 @@ bool FileSplitterAndMerger::MergeFile(const std::string& outFilePath,
     }
 
     // 4) 정렬된 순서대로 data를 이어붙여 파일에 기록
+    uint64_t totalBytes = 0;
     for (const auto& p : ordered) {
+        totalBytes += RawLength(p);
+
+        // 0 청크는 쓰지 않고 건너뛰어 구멍으로 남긴다
+        if (p.flags & PACKET_FLAG_ZERO) {
+            out.seekp(static_cast<std::streamoff>(totalBytes));
+            continue;
+        }
+
         // length가 data 크기보다 크면 잘못된 패킷
         if (p.length > p.data.size()) {
             std::cerr << "[MergeFile] Invalid packet length (seq=" << p.seq << ")\n";
             return false;
         }
 
+        // 압축된 Packet 은 원본으로 풀어서 기록
+        if (p.flags & PACKET_FLAG_COMPRESSED) {
+            const auto* src = reinterpret_cast<const unsigned char*>(p.data.data());
+            uint32_t rawLength = 0;
+            if (!LzReadRawLength(src, p.length, rawLength)) {
+                std::cerr << "[MergeFile] Invalid compressed packet (seq=" << p.seq << ")\n";
+                return false;
+            }
+            std::vector<unsigned char> raw(rawLength);
+            if (!LzDecompress(src, p.length, raw.data(), raw.size())) {
+                std::cerr << "[MergeFile] Decompress failed (seq=" << p.seq << ")\n";
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(raw.data()),
+                      static_cast<std::streamsize>(raw.size()));
+            continue;
+        }
+
         // data의 앞부분 length만큼 파일에 쓰기
         out.write(p.data.data(),
                   static_cast<std::streamsize>(p.length));
     }
 
-    // 5) 파일 쓰기 상태 확인 후 반환
-    return static_cast<bool>(out);
+    // 5) 파일 쓰기 상태 확인
+    if (!out)
+        return false;
+    out.close();
+
+    // 0 청크로 끝나는 파일은 끝의 구멍까지 크기를 맞춘다
+    std::error_code ec;
+    if (std::filesystem::file_size(outFilePath, ec) != totalBytes)
+        std::filesystem::resize_file(outFilePath, totalBytes, ec);
+    return !ec;
 }
 
 // ================================================================
@@ -198,3 +471,519 @@ bool FileSplitterAndMerger::DecodePacket(const std::string& raw, Packet& out)
 
     return true;
 }
+
+// ================================================================
+//  파일 전체 다이제스트: 모든 data 를 순서대로 이어서 CRC32C 누적
+// ================================================================
+uint32_t FileSplitterAndMerger::ComputeFileDigest(const std::vector<Packet>& packets)
+{
+    Crc32cDigest digest;
+    for (const auto& p : packets) {
+        if (p.flags & PACKET_FLAG_ZERO) {
+            // 0 청크는 0 버퍼로 대신 누적
+            for (uint32_t left = RawLength(p); left > 0; ) {
+                uint32_t n = std::min<uint32_t>(left, ZERO_BUFFER_BYTES);
+                digest.Update(ZeroBuffer(), n);
+                left -= n;
+            }
+            continue;
+        }
+        digest.Update(p.data.data(), p.length);
+    }
+    return digest.Value();
+}
+
+// ================================================================
+//  FEC 패리티 생성: 그룹(k개)마다 인터리브 XOR 패리티 m개
+// ================================================================
+std::vector<Packet> FileSplitterAndMerger::BuildParityPackets(const std::vector<Packet>& packets,
+                                                              uint32_t k, uint32_t m)
+{
+    std::vector<Packet> parity;
+
+    // 1) 파라미터 유효성 체크
+    if (k == 0 || m == 0 || m > k) {
+        std::cerr << "[BuildParityPackets] invalid k/m (k=" << k << ", m=" << m << ")\n";
+        return parity;
+    }
+
+    uint64_t groups = FecGroupCount(packets.size(), k);
+    parity.reserve(groups * m);
+
+    for (uint64_t g = 0; g < groups; ++g) {
+        uint64_t first = g * k;
+        uint64_t last  = std::min<uint64_t>(first + k, packets.size());
+
+        for (uint32_t j = 0; j < m; ++j) {
+            // 2) 스트라이프에서 가장 긴 청크 길이만큼 버퍼 확보 (짧은 청크는 0 패딩으로 간주)
+            std::size_t maxLen = 0;
+            for (uint64_t i = first + j; i < last; i += m)
+                maxLen = std::max<std::size_t>(maxLen, RawLength(packets[i]));
+
+            std::string buf(FEC_PARITY_LEN_BYTES + maxLen, '\0');
+            auto* lenOut  = reinterpret_cast<unsigned char*>(buf.data());
+            auto* dataOut = lenOut + FEC_PARITY_LEN_BYTES;
+
+            // 3) 길이와 데이터를 모두 XOR 누적
+            uint32_t lenXor = 0;
+            for (uint64_t i = first + j; i < last; i += m) {
+                lenXor ^= RawLength(packets[i]);
+                if (packets[i].flags & PACKET_FLAG_ZERO)
+                    continue; // 0 과의 XOR 은 그대로
+                FecXorInto(dataOut,
+                           reinterpret_cast<const unsigned char*>(packets[i].data.data()),
+                           packets[i].length);
+            }
+            for (std::size_t b = 0; b < FEC_PARITY_LEN_BYTES; ++b)
+                lenOut[b] = static_cast<unsigned char>(lenXor >> (8 * b));
+
+            Packet p;
+            p.seq      = static_cast<uint32_t>(g * m + j);
+            p.length   = static_cast<uint32_t>(buf.size());
+            p.data     = std::move(buf);
+            p.checksum = Crc32c(p.data.data(), p.data.size());
+            parity.push_back(std::move(p));
+        }
+    }
+
+    return parity;
+}
+
+// ================================================================
+//  청크 단위 압축: 샘플로 먼저 판단한 뒤 청크마다 독립 압축
+// ================================================================
+bool FileSplitterAndMerger::CompressPackets(std::vector<Packet>& packets)
+{
+    if (packets.empty())
+        return false;
+
+    std::string compressed;
+
+    // 1) 파일 전체에서 고르게 샘플을 뽑아 압축률 확인
+    std::size_t step = std::max<std::size_t>(1, packets.size() / COMPRESS_PROBE_CHUNKS);
+    std::size_t rawBytes = 0, packedBytes = 0;
+    for (std::size_t i = 0; i < packets.size(); i += step) {
+        if (packets[i].flags & PACKET_FLAG_ZERO)
+            continue;
+        rawBytes    += packets[i].length;
+        packedBytes += LzCompress(packets[i].data.data(), packets[i].length, compressed);
+    }
+    if (rawBytes == 0 || packedBytes > rawBytes * COMPRESS_PROBE_RATIO)
+        return false; // 압축 효과가 거의 없는 파일 (이미 압축된 파일 등)
+
+    // 2) 청크마다 독립적으로 압축, 작아지지 않으면 원본 유지
+    bool any = false;
+    for (auto& p : packets) {
+        if (p.flags & PACKET_FLAG_ZERO)
+            continue; // 이미 구간 표식
+
+        LzCompress(p.data.data(), p.length, compressed);
+        if (compressed.size() >= p.length)
+            continue;
+
+        p.data.swap(compressed);
+        p.length    = static_cast<uint32_t>(p.data.size());
+        p.checksum  = Crc32c(p.data.data(), p.data.size());
+        p.flags    |= PACKET_FLAG_COMPRESSED;
+        any = true;
+    }
+
+    return any;
+}
+
+// ================================================================
+//  Packet 이 나타내는 원본 바이트 수
+// ================================================================
+uint32_t FileSplitterAndMerger::RawLength(const Packet& p)
+{
+    const auto* data = reinterpret_cast<const unsigned char*>(p.data.data());
+
+    if (p.flags & PACKET_FLAG_ZERO) {
+        ZeroRange range{};
+        if (!DecodeZeroRange(data, p.data.size(), range))
+            return 0;
+        return range.chunkLength * (range.count - 1) + range.lastLength;
+    }
+
+    if (p.flags & PACKET_FLAG_COMPRESSED) {
+        uint32_t rawLength = 0;
+        return LzReadRawLength(data, p.data.size(), rawLength) ? rawLength : 0;
+    }
+
+    return p.length;
+}
+
+// ================================================================
+//  연속된 0 Packet 들을 하나의 구간 표식으로 묶기
+// ================================================================
+Packet FileSplitterAndMerger::BuildZeroRangePacket(const std::vector<Packet>& packets,
+                                                   std::size_t begin, std::size_t end)
+{
+    ZeroRange range{};
+    range.count       = static_cast<uint32_t>(end - begin);
+    range.chunkLength = RawLength(packets[begin]);
+    range.lastLength  = RawLength(packets[end - 1]);
+
+    Packet p;
+    p.seq      = static_cast<uint32_t>(begin);
+    p.data     = EncodeZeroRange(range);
+    p.length   = static_cast<uint32_t>(p.data.size());
+    p.checksum = Crc32c(p.data.data(), p.data.size());
+    p.flags    = PACKET_FLAG_ZERO;
+    return p;
+}
+
+// ================================================================
+//  SplitFileContentDefined 구현: 파일 -> 내용 기반 가변 길이 Packet 벡터
+// ================================================================
+std::vector<Packet> FileSplitterAndMerger::SplitFileContentDefined(const std::string& filePath,
+                                                                   std::size_t minSize,
+                                                                   std::size_t avgSize,
+                                                                   std::size_t maxSize)
+{
+    std::vector<Packet> packets;
+
+    // 1) 크기 유효성 체크
+    if (minSize == 0 || minSize > avgSize || avgSize > maxSize || (avgSize & (avgSize - 1)) != 0) {
+        std::cerr << "[SplitFileContentDefined] invalid sizes (min=" << minSize
+                  << ", avg=" << avgSize << ", max=" << maxSize << ")\n";
+        return packets;
+    }
+
+    // 2) 파일 열기
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) {
+        std::cerr << "[SplitFileContentDefined] Failed to open file: " << filePath << "\n";
+        return packets;
+    }
+
+    // 3) 평균 크기 비트 수 기준으로 어려운/쉬운 마스크 결정 (FastCDC 정규화 청킹)
+    int avgBits = 0;
+    while ((std::size_t{1} << avgBits) < avgSize) ++avgBits;
+    uint64_t maskHard = TopBitsMask(avgBits + 2);
+    uint64_t maskEasy = TopBitsMask(avgBits - 2);
+
+    // 4) 최대 청크 여러 개 분량씩 읽어가며 자른다
+    std::vector<unsigned char> buffer(maxSize * 64);
+    std::size_t filled = 0;
+    std::size_t pos = 0;
+    uint32_t seq = 0;
+    bool eof = false;
+
+    while (true) {
+        // 남은 데이터가 최대 청크보다 작으면 앞으로 당기고 더 읽는다
+        if (!eof && filled - pos < maxSize) {
+            std::memmove(buffer.data(), buffer.data() + pos, filled - pos);
+            filled -= pos;
+            pos = 0;
+            in.read(reinterpret_cast<char*>(buffer.data() + filled),
+                    static_cast<std::streamsize>(buffer.size() - filled));
+            filled += static_cast<std::size_t>(in.gcount());
+            eof = !in;
+        }
+        if (pos >= filled)
+            break;
+
+        std::size_t cut = FindCutPoint(buffer.data() + pos, filled - pos,
+                                       minSize, avgSize, maxSize, maskHard, maskEasy);
+
+        Packet p;
+        p.seq      = seq++;
+        p.length   = static_cast<uint32_t>(cut);
+        p.data.assign(reinterpret_cast<const char*>(buffer.data() + pos), cut);
+        p.checksum = Crc32c(p.data.data(), p.data.size());
+        packets.push_back(std::move(p));
+
+        pos += cut;
+    }
+
+    return packets;
+}
+
+// ================================================================
+//  청크 매니페스트 생성 / 인코딩 / 디코딩
+// ================================================================
+std::vector<ChunkManifestEntry> FileSplitterAndMerger::BuildManifest(const std::vector<Packet>& packets)
+{
+    std::vector<ChunkManifestEntry> manifest;
+    manifest.reserve(packets.size());
+    for (const auto& p : packets)
+        manifest.push_back({ChunkHash64(p.data.data(), p.length), p.length});
+    return manifest;
+}
+
+std::string FileSplitterAndMerger::EncodeManifest(const std::vector<ChunkManifestEntry>& manifest)
+{
+    std::ostringstream oss;
+    oss << std::hex;
+    for (std::size_t i = 0; i < manifest.size(); ++i) {
+        if (i > 0) oss << ',';
+        oss << manifest[i].hash << ':' << std::dec << manifest[i].length << std::hex;
+    }
+    return oss.str();
+}
+
+bool FileSplitterAndMerger::DecodeManifest(const std::string& raw, std::vector<ChunkManifestEntry>& out)
+{
+    std::size_t pos = 0;
+    while (pos < raw.size()) {
+        std::size_t comma = raw.find(',', pos);
+        if (comma == std::string::npos) comma = raw.size();
+
+        std::size_t colon = raw.find(':', pos);
+        if (colon == std::string::npos || colon > comma) {
+            std::cerr << "[DecodeManifest] ':' not found\n";
+            return false;
+        }
+
+        try {
+            ChunkManifestEntry e;
+            e.hash   = std::stoull(raw.substr(pos, colon - pos), nullptr, 16);
+            e.length = static_cast<uint32_t>(std::stoul(raw.substr(colon + 1, comma - colon - 1)));
+            out.push_back(e);
+        } catch (const std::exception& e) {
+            std::cerr << "[DecodeManifest] stoi error: " << e.what() << "\n";
+            return false;
+        }
+
+        pos = comma + 1;
+    }
+    return true;
+}
+
+// ================================================================
+//  SplitDirectory 구현: 디렉터리 -> 하나의 Packet 스트림 + 인덱스
+// ================================================================
+std::vector<Packet> FileSplitterAndMerger::SplitDirectory(const std::string& dirPath,
+                                                          std::size_t payloadSize,
+                                                          std::vector<DirectoryEntry>& index,
+                                                          uint64_t smallFileBytes)
+{
+    namespace fs = std::filesystem;
+
+    std::vector<Packet> packets;
+    index.clear();
+
+    if (payloadSize == 0) {
+        std::cerr << "[SplitDirectory] payloadSize must be > 0\n";
+        return packets;
+    }
+
+    // 1) 일반 파일 목록 수집 (상대 경로 순으로 정렬해서 항상 같은 순서)
+    std::error_code ec;
+    std::vector<std::pair<std::string, uint64_t>> smallFiles, largeFiles;
+    for (fs::recursive_directory_iterator it(dirPath, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec))
+            continue;
+        std::string rel = fs::relative(it->path(), dirPath, ec).generic_string();
+        uint64_t size = it->file_size(ec);
+        (size <= smallFileBytes ? smallFiles : largeFiles).emplace_back(rel, size);
+    }
+    if (ec) {
+        std::cerr << "[SplitDirectory] Failed to read directory: " << dirPath << "\n";
+        return packets;
+    }
+    std::sort(smallFiles.begin(), smallFiles.end());
+    std::sort(largeFiles.begin(), largeFiles.end());
+
+    // 가득 찬 청크를 Packet 으로 내보내는 람다
+    std::string current;
+    current.reserve(payloadSize);
+    auto flushCurrent = [&]() {
+        if (current.empty())
+            return;
+        Packet p;
+        p.seq      = static_cast<uint32_t>(packets.size());
+        p.length   = static_cast<uint32_t>(current.size());
+        p.checksum = Crc32c(current.data(), current.size());
+        p.data     = std::move(current);
+        packets.push_back(std::move(p));
+        current.clear();
+        current.reserve(payloadSize);
+    };
+
+    // 2) 작은 파일들은 청크 경계와 상관없이 이어 붙인다
+    std::vector<char> buffer(smallFileBytes);
+    for (const auto& [rel, size] : smallFiles) {
+        std::ifstream in(fs::path(dirPath) / rel, std::ios::binary);
+        in.read(buffer.data(), static_cast<std::streamsize>(size));
+        if (!in && static_cast<uint64_t>(in.gcount()) != size) {
+            std::cerr << "[SplitDirectory] Failed to read file: " << rel << "\n";
+            continue;
+        }
+
+        index.push_back({rel, size, packets.size(), static_cast<uint32_t>(current.size())});
+
+        for (uint64_t done = 0; done < size; ) {
+            std::size_t n = std::min<uint64_t>(payloadSize - current.size(), size - done);
+            current.append(buffer.data() + done, n);
+            done += n;
+            if (current.size() == payloadSize)
+                flushCurrent();
+        }
+    }
+    flushCurrent();
+
+    // 3) 큰 파일은 새 청크부터 SplitFile 결과를 이어 붙인다 (0/구멍 청크 생략 포함)
+    for (const auto& [rel, size] : largeFiles) {
+        auto filePackets = SplitFile((fs::path(dirPath) / rel).string(), payloadSize);
+
+        index.push_back({rel, size, packets.size(), 0});
+        for (auto& p : filePackets) {
+            p.seq = static_cast<uint32_t>(packets.size());
+            packets.push_back(std::move(p));
+        }
+    }
+
+    return packets;
+}
+
+// ================================================================
+//  MergeDirectory 구현: Packet 스트림 + 인덱스 -> 파일들 (병렬 쓰기)
+// ================================================================
+bool FileSplitterAndMerger::MergeDirectory(const std::string& outDir,
+                                           const std::vector<Packet>& packets,
+                                           const std::vector<DirectoryEntry>& index,
+                                           unsigned writerThreads)
+{
+    namespace fs = std::filesystem;
+
+    // 1) seq 순서로 바로 찾을 수 있도록 정렬된 포인터 배열 준비
+    std::vector<const Packet*> ordered(packets.size(), nullptr);
+    for (const auto& p : packets) {
+        if (p.seq >= ordered.size()) {
+            std::cerr << "[MergeDirectory] packet seq out of range (seq=" << p.seq << ")\n";
+            return false;
+        }
+        ordered[p.seq] = &p;
+    }
+
+    // 2) 파일 하나를 쓰는 작업
+    auto writeEntry = [&](const DirectoryEntry& e, std::vector<unsigned char>& scratch) -> bool {
+        fs::path rel(e.path);
+        if (rel.is_absolute() || e.path.find("..") != std::string::npos) {
+            std::cerr << "[MergeDirectory] Rejected path: " << e.path << "\n";
+            return false;
+        }
+
+        fs::path target = fs::path(outDir) / rel;
+        std::error_code ec;
+        fs::create_directories(target.parent_path(), ec);
+
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[MergeDirectory] Failed to open output file: " << target << "\n";
+            return false;
+        }
+
+        uint64_t remaining = e.size;
+        uint64_t written = 0;
+        uint64_t seq = e.firstPacket;
+        std::size_t offset = e.firstOffset;
+        while (remaining > 0) {
+            const char* data = nullptr;
+            std::size_t length = 0;
+            if (seq >= ordered.size() || !ordered[seq] ||
+                !PacketRawView(*ordered[seq], scratch, data, length) || offset > length) {
+                std::cerr << "[MergeDirectory] Missing packet for " << e.path << " (seq=" << seq << ")\n";
+                return false;
+            }
+
+            std::size_t n = std::min<uint64_t>(remaining, length - offset);
+            if (data)
+                out.write(data + offset, static_cast<std::streamsize>(n));
+            written += n;
+            if (!data)
+                out.seekp(static_cast<std::streamoff>(written)); // 0 청크는 구멍으로
+
+            remaining -= n;
+            offset = 0;
+            ++seq;
+        }
+
+        if (!out)
+            return false;
+        out.close();
+
+        if (fs::file_size(target, ec) != e.size)
+            fs::resize_file(target, e.size, ec);
+        return !ec;
+    };
+
+    // 3) 여러 스레드가 인덱스 항목을 하나씩 가져가며 쓴다
+    if (writerThreads == 0)
+        writerThreads = std::max(1u, std::min(DIR_MAX_WRITERS, std::thread::hardware_concurrency()));
+    writerThreads = std::min<unsigned>(writerThreads, std::max<std::size_t>(1, index.size()));
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> ok{true};
+    auto worker = [&]() {
+        std::vector<unsigned char> scratch;
+        for (std::size_t i = next++; i < index.size(); i = next++) {
+            if (!writeEntry(index[i], scratch))
+                ok = false;
+        }
+    };
+
+    std::vector<std::thread> writers;
+    for (unsigned t = 1; t < writerThreads; ++t)
+        writers.emplace_back(worker);
+    worker();
+    for (auto& t : writers)
+        t.join();
+
+    return ok;
+}
+
+// ================================================================
+//  디렉터리 인덱스 인코딩 / 디코딩
+//  포맷: path,size,firstPacket,firstOffset;path,size,...
+// ================================================================
+std::string FileSplitterAndMerger::EncodeDirectoryIndex(const std::vector<DirectoryEntry>& index)
+{
+    std::ostringstream oss;
+    for (std::size_t i = 0; i < index.size(); ++i) {
+        if (i > 0) oss << ';';
+        oss << EscapePath(index[i].path) << ','
+            << index[i].size << ','
+            << index[i].firstPacket << ','
+            << index[i].firstOffset;
+    }
+    return oss.str();
+}
+
+bool FileSplitterAndMerger::DecodeDirectoryIndex(const std::string& raw, std::vector<DirectoryEntry>& out)
+{
+    std::size_t pos = 0;
+    while (pos < raw.size()) {
+        std::size_t semi = raw.find(';', pos);
+        if (semi == std::string::npos) semi = raw.size();
+
+        std::string item = raw.substr(pos, semi - pos);
+        std::size_t c1 = item.find(',');
+        std::size_t c2 = (c1 == std::string::npos) ? c1 : item.find(',', c1 + 1);
+        std::size_t c3 = (c2 == std::string::npos) ? c2 : item.find(',', c2 + 1);
+        if (c3 == std::string::npos) {
+            std::cerr << "[DecodeDirectoryIndex] ',' not found\n";
+            return false;
+        }
+
+        DirectoryEntry e;
+        if (!UnescapePath(item.substr(0, c1), e.path)) {
+            std::cerr << "[DecodeDirectoryIndex] bad path escape\n";
+            return false;
+        }
+        try {
+            e.size        = std::stoull(item.substr(c1 + 1, c2 - c1 - 1));
+            e.firstPacket = std::stoull(item.substr(c2 + 1, c3 - c2 - 1));
+            e.firstOffset = static_cast<uint32_t>(std::stoul(item.substr(c3 + 1)));
+        } catch (const std::exception& ex) {
+            std::cerr << "[DecodeDirectoryIndex] stoi error: " << ex.what() << "\n";
+            return false;
+        }
+        out.push_back(std::move(e));
+
+        pos = semi + 1;
+    }
+    return true;
+}
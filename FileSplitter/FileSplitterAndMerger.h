@@ -3,6 +3,31 @@
 
 #include "IFileSplitterAndMerger.h"
 
+/**
+ * @brief 내용 기반 청킹(CDC) 매니페스트의 한 항목
+ *
+ * - 송신 측이 TCP 로 보내는 청크 목록이며, 수신 측은 hash/length 가 같은 청크를
+ *   로컬에서 찾아 UDP 전송 없이 채운다.
+ */
+struct ChunkManifestEntry {
+    uint64_t hash;    // ChunkHash64(data)
+    uint32_t length;  // 청크 바이트 수
+};
+
+/**
+ * @brief 디렉터리 전송 인덱스의 한 항목
+ *
+ * - 디렉터리 전체를 하나의 Packet 스트림으로 보낼 때,
+ *   각 파일의 데이터가 스트림의 어디서 시작하는지 기록한다.
+ * - 작은 파일들은 청크 경계와 상관없이 이어 붙여지므로 firstOffset 이 0이 아닐 수 있다.
+ */
+struct DirectoryEntry {
+    std::string path;      // 디렉터리 기준 상대 경로
+    uint64_t size;         // 파일 크기
+    uint64_t firstPacket;  // 파일 데이터가 시작되는 Packet 번호
+    uint32_t firstOffset;  // 그 Packet 의 원본 데이터 안에서 시작 위치
+};
+
 /**
  * @brief IFileSplitterAndMerger 인터페이스를 실제로 구현한 클래스
  *
@@ -28,6 +53,8 @@ public:
      *   - 파일이 10000바이트이고 payloadSize가 1024라면,
      *     대략 10개의 Packet이 만들어진다.
      *   - 각 Packet에는 seq(순번), length(실제 바이트 길이), data(실제내용)가 들어간다.
+     *   - 희소 파일의 구멍(SEEK_HOLE)에 걸친 청크는 읽지 않고, 읽은 청크가 전부 0이면
+     *     PACKET_FLAG_ZERO 가 켜진 구간 표식 Packet 으로 대신한다. (RawLength 참고)
      */
     std::vector<Packet> SplitFile(const std::string& filePath,
                                   std::size_t payloadSize) override;
@@ -43,6 +70,104 @@ public:
     bool MergeFile(const std::string& outFilePath,
                    const std::vector<Packet>& packets) override;
 
+    /**
+     * @brief 파일을 내용 기반(Gear 롤링 해시, FastCDC 방식)으로 잘라 Packet 벡터를 생성한다.
+     *
+     * @param filePath  분할할 파일 경로
+     * @param minSize   청크 최소 크기
+     * @param avgSize   목표 평균 청크 크기 (2의 거듭제곱)
+     * @param maxSize   청크 최대 크기 (UDP 데이터그램 하나에 들어가야 함)
+     *
+     * @return 분할된 Packet 목록 (실패 시 빈 벡터)
+     *
+     * @details
+     *   - 자르는 위치가 앞쪽 바이트 위치가 아니라 내용으로 정해지므로,
+     *     파일 중간에 바이트가 끼어들어도 그 근처 청크만 바뀌고 나머지는 그대로다.
+     *   - 평균 크기 전에는 더 어려운 마스크, 이후에는 쉬운 마스크를 써서
+     *     청크 크기 분포를 평균 근처로 모은다.
+     */
+    std::vector<Packet> SplitFileContentDefined(const std::string& filePath,
+                                                std::size_t minSize = CDC_MIN_SIZE,
+                                                std::size_t avgSize = CDC_AVG_SIZE,
+                                                std::size_t maxSize = CDC_MAX_SIZE);
+
+    // 내용 기반 청킹 기본 크기 (최대 크기는 UDP 헤더와 합쳐 1500바이트 MTU 안에 들어가도록)
+    static constexpr std::size_t CDC_MIN_SIZE = 256;
+    static constexpr std::size_t CDC_AVG_SIZE = 1024;
+    static constexpr std::size_t CDC_MAX_SIZE = 1400;
+
+    /**
+     * @brief Packet 목록으로부터 청크 매니페스트를 만든다.
+     */
+    static std::vector<ChunkManifestEntry> BuildManifest(const std::vector<Packet>& packets);
+
+    /**
+     * @brief 매니페스트를 "hash(16진수):length,..." 문자열로 인코딩한다. (FILE_MANIFEST 로 전송)
+     */
+    static std::string EncodeManifest(const std::vector<ChunkManifestEntry>& manifest);
+
+    /**
+     * @brief "hash:length,..." 문자열을 매니페스트로 디코딩한다.
+     * @return 형식 오류 시 false
+     */
+    static bool DecodeManifest(const std::string& raw, std::vector<ChunkManifestEntry>& out);
+
+    /**
+     * @brief 디렉터리 아래 모든 파일을 하나의 Packet 스트림으로 분할한다.
+     *
+     * @param dirPath         보낼 디렉터리
+     * @param payloadSize     Packet 하나에 담을 최대 바이트 수
+     * @param index           파일별 위치 인덱스 (출력 매개변수, DIR_INDEX 로 전송)
+     * @param smallFileBytes  이 크기 이하의 파일은 이어 붙여서 묶는다
+     *
+     * @return 분할된 Packet 목록 (seq 는 스트림 전체 기준)
+     *
+     * @details
+     *   - 작은 파일들을 먼저 하나의 연속된 바이트 스트림으로 이어 붙여 청크로 자르고,
+     *     큰 파일은 그 뒤에 새 청크 경계부터 SplitFile 결과를 그대로 이어 붙인다.
+     *   - 파일마다 전송 세션/캐시/완료 응답을 따로 두지 않으므로
+     *     작은 파일이 많아도 파일당 고정 비용이 없다.
+     */
+    std::vector<Packet> SplitDirectory(const std::string& dirPath,
+                                       std::size_t payloadSize,
+                                       std::vector<DirectoryEntry>& index,
+                                       uint64_t smallFileBytes = DIR_SMALL_FILE_BYTES);
+
+    /**
+     * @brief SplitDirectory 로 만든 Packet 스트림을 인덱스대로 파일들로 풀어 쓴다.
+     *
+     * @param outDir         결과를 만들 디렉터리
+     * @param packets        수신된 Packet 목록 (seq 가 섞여 있어도 됨, 빠진 번호가 있으면 실패)
+     * @param index          DIR_INDEX 로 받은 인덱스
+     * @param writerThreads  동시에 파일을 쓰는 스레드 수 (0이면 CPU 수에 맞춤)
+     *
+     * @return 모든 파일을 썼으면 true
+     *
+     * @details
+     *   - 상대 경로에 ".." 이 있거나 절대 경로인 항목은 거부한다.
+     */
+    bool MergeDirectory(const std::string& outDir,
+                        const std::vector<Packet>& packets,
+                        const std::vector<DirectoryEntry>& index,
+                        unsigned writerThreads = 0);
+
+    // 이 크기 이하의 파일은 다른 작은 파일들과 이어 붙여 보낸다
+    static constexpr uint64_t DIR_SMALL_FILE_BYTES = 64 * 1024;
+    // MergeDirectory 기본 최대 쓰기 스레드 수
+    static constexpr unsigned DIR_MAX_WRITERS = 8;
+
+    /**
+     * @brief 디렉터리 인덱스를 "path,size,firstPacket,firstOffset;..." 문자열로 인코딩한다.
+     *        (path 의 공백/구분자 등은 %XX 로 이스케이프)
+     */
+    static std::string EncodeDirectoryIndex(const std::vector<DirectoryEntry>& index);
+
+    /**
+     * @brief EncodeDirectoryIndex 문자열을 인덱스로 디코딩한다.
+     * @return 형식 오류 시 false
+     */
+    static bool DecodeDirectoryIndex(const std::string& raw, std::vector<DirectoryEntry>& out);
+
     // ================================================================
     //       네트워크 전송을 위한 Packet <-> 문자열 포맷 변환 유틸
     // ================================================================
@@ -71,6 +196,66 @@ public:
      */
     static bool DecodePacket(const std::string& raw, Packet& out);
 
+    /**
+     * @brief seq 순서로 정렬된 Packet 들의 data 를 이어붙인 파일 전체 CRC32C 를 계산한다.
+     *
+     * @param packets  SplitFile 결과 (seq 순서)
+     * @return         파일 전체 다이제스트 (FILE_SEND_DONE 으로 수신 측에 전달)
+     */
+    static uint32_t ComputeFileDigest(const std::vector<Packet>& packets);
+
+    /**
+     * @brief 데이터 Packet 들로부터 FEC 패리티 Packet 들을 생성한다.
+     *
+     * @param packets  SplitFile 결과 (seq 순서)
+     * @param k        그룹당 데이터 청크 수
+     * @param m        그룹당 패리티 청크 수 (1 <= m <= k)
+     *
+     * @return 패리티 Packet 목록 (seq = 그룹번호 * m + j, 실패 시 빈 벡터)
+     *
+     * @details
+     *   - 그룹 g 의 j 번째 패리티는 그룹 안에서 (i % m) == j 인 데이터 청크들의 XOR 이다.
+     *   - 수신 측은 스트라이프마다 손실이 1개면 TCP 재전송 요청 없이 직접 복원한다.
+     *   - 패리티 payload 형식은 Fec.h 참고.
+     */
+    static std::vector<Packet> BuildParityPackets(const std::vector<Packet>& packets,
+                                                  uint32_t k, uint32_t m);
+
+    /**
+     * @brief 압축이 효과 있는 파일이면 각 Packet 의 data 를 독립적으로 LZ 압축한다.
+     *
+     * @param packets  SplitFile 결과 (압축된 Packet 은 data/length/checksum 이 바뀌고
+     *                 flags 에 PACKET_FLAG_COMPRESSED 가 켜진다)
+     *
+     * @return 한 개 이상 압축했으면 true
+     *
+     * @details
+     *   - 먼저 고르게 뽑은 샘플 청크 몇 개를 압축해 보고,
+     *     압축률이 COMPRESS_PROBE_RATIO 보다 나쁘면 전체를 원본 그대로 둔다.
+     *   - 압축해도 작아지지 않는 청크는 개별적으로 원본 그대로 보낸다.
+     *   - 청크끼리 의존하지 않으므로 재전송 시 청크 하나만 다시 보내도 된다.
+     *   - 파일 다이제스트/FEC 패리티는 원본 기준이므로 이 함수보다 먼저 계산한다.
+     */
+    static bool CompressPackets(std::vector<Packet>& packets);
+
+    /**
+     * @brief Packet 이 나타내는 원본 바이트 수 (압축/0 구간 표식이면 풀었을 때 길이)
+     */
+    static uint32_t RawLength(const Packet& p);
+
+    /**
+     * @brief [begin, end) 의 연속된 0 Packet 들을 하나의 구간 표식 Packet 으로 묶는다.
+     *
+     * @return seq = begin 인 PACKET_FLAG_ZERO Packet (전송용, 캐시에는 넣지 않음)
+     */
+    static Packet BuildZeroRangePacket(const std::vector<Packet>& packets,
+                                       std::size_t begin, std::size_t end);
+
+    // 샘플 압축 결과가 원본의 이 비율보다 크면 압축하지 않음
+    static constexpr double COMPRESS_PROBE_RATIO = 0.9;
+    // 샘플로 압축해 볼 청크 수
+    static constexpr std::size_t COMPRESS_PROBE_CHUNKS = 8;
+
     // 패킷 포맷에 사용하는 특수 문자들 (상수)
     // 예: [seq] | [length] { data }
     static constexpr char PACKET_DELIM = '|'; // seq와 length를 구분하는 문자
@@ -5,6 +5,10 @@
 #include <vector>
 #include <cstdint>
 
+// Packet::flags 비트
+constexpr uint8_t PACKET_FLAG_COMPRESSED = 0x01; // data 가 LZ 압축되어 있음 (Lz.h 포맷)
+constexpr uint8_t PACKET_FLAG_ZERO       = 0x02; // 원본이 전부 0 (data 는 ZeroRange.h 구간 표식)
+
 /**
  * @brief 한 개의 "전송 단위"를 나타내는 구조체
  *
@@ -17,6 +21,8 @@ struct Packet {
     uint32_t seq;        // 패킷 번호 (0부터 시작하는 순번, 0, 1, 2, ...)
     uint32_t length;     // data에 실제로 들어있는 바이트 수
     std::string data;    // 실제 데이터 (이 패킷에 담긴 내용, 바이너리/텍스트 모두 가능)
+    uint32_t checksum = 0; // data 의 CRC32C (SplitFile 이 채움, 재전송 시에도 재사용)
+    uint8_t  flags    = 0; // PACKET_FLAG_* 조합
 };
 
 /**
@@ -0,0 +1,233 @@
+#include "ControlFrame.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// ------------------------------------
+// Framing
+// ------------------------------------
+
+std::string EncodeControlFrame(std::string_view Payload)
+{
+    /** 4-byte big-endian length, then the payload */
+
+    uint32_t Length = static_cast<uint32_t>(Payload.size());
+
+    std::string Frame;
+    Frame.reserve(ControlFrameHeaderBytes + Payload.size());
+    Frame.push_back(static_cast<char>(Length >> 24));
+    Frame.push_back(static_cast<char>(Length >> 16));
+    Frame.push_back(static_cast<char>(Length >> 8));
+    Frame.push_back(static_cast<char>(Length));
+    Frame.append(Payload);
+    return Frame;
+}
+
+// ------------------------------------
+// Ring buffer reader
+// ------------------------------------
+
+ControlFrameReader::ControlFrameReader()
+    : Buffer(new char[Capacity])
+{
+}
+
+ControlFrameReader::EReadResult ControlFrameReader::ReadFrom(int Socket)
+{
+    /** Fill the free part of the ring (up to two segments) until the socket runs dry */
+
+    if (bSpilling)
+    {
+        EReadResult SpillResult = ReadSpill(Socket);
+        if (SpillResult != EReadResult::Full)
+            return SpillResult;
+    }
+    else if (!Spill.empty())
+    {
+        // The long frame handed out last time is no longer referenced
+        std::string().swap(Spill);
+    }
+
+    while (true)
+    {
+        std::size_t Used = static_cast<std::size_t>(Tail - Head);
+        std::size_t Free = Capacity - Used;
+        if (Free == 0)
+            return EReadResult::Full;
+
+        std::size_t Start = static_cast<std::size_t>(Tail & Mask);
+        std::size_t First = std::min(Free, Capacity - Start);
+
+        iovec Iov[2];
+        Iov[0] = {Buffer.get() + Start, First};
+        Iov[1] = {Buffer.get(), Free - First};
+
+        msghdr Msg{};
+        Msg.msg_iov = Iov;
+        Msg.msg_iovlen = (Free > First) ? 2 : 1;
+
+        ssize_t Received = recvmsg(Socket, &Msg, MSG_DONTWAIT);
+        if (Received > 0)
+        {
+            Tail += static_cast<uint64_t>(Received);
+            continue;
+        }
+
+        if (Received < 0 && errno == EINTR)
+            continue;
+        if (Received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return EReadResult::Drained;
+
+        return EReadResult::Closed;
+    }
+}
+
+ControlFrameReader::EReadResult ControlFrameReader::ReadSpill(int Socket)
+{
+    /** Read straight into the long frame's own buffer, never past its end */
+
+    while (SpillFilled < Spill.size())
+    {
+        ssize_t Received = recv(Socket, Spill.data() + SpillFilled, Spill.size() - SpillFilled, MSG_DONTWAIT);
+        if (Received > 0)
+        {
+            SpillFilled += static_cast<std::size_t>(Received);
+            continue;
+        }
+
+        if (Received < 0 && errno == EINTR)
+            continue;
+        if (Received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return EReadResult::Drained;
+
+        return EReadResult::Closed;
+    }
+
+    return EReadResult::Full;
+}
+
+bool ControlFrameReader::NextFrame(std::string_view& OutFrame)
+{
+    /** Parse one length-prefixed frame in place; wrapped frames are linearized into Scratch */
+
+    if (bError)
+        return false;
+
+    if (bSpilling)
+    {
+        if (SpillFilled < Spill.size())
+            return false;
+
+        // Complete long frame; it precedes everything now in the ring
+        OutFrame = Spill;
+        bSpilling = false;
+        return true;
+    }
+
+    std::size_t Used = static_cast<std::size_t>(Tail - Head);
+    if (Used < ControlFrameHeaderBytes)
+        return false;
+
+    uint32_t Length = 0;
+    for (std::size_t i = 0; i < ControlFrameHeaderBytes; ++i)
+        Length = (Length << 8) | static_cast<unsigned char>(Buffer[(Head + i) & Mask]);
+
+    if (Length > MaxFrameBytes)
+    {
+        bError = true;
+        return false;
+    }
+
+    if (Length > MaxRingFrameBytes)
+    {
+        /** Too long for the ring: move what has arrived into a buffer of the frame's size, read the rest there */
+        Head += ControlFrameHeaderBytes;
+        std::size_t Buffered = std::min(static_cast<std::size_t>(Tail - Head), static_cast<std::size_t>(Length));
+
+        std::size_t Start = static_cast<std::size_t>(Head & Mask);
+        std::size_t First = std::min(Buffered, Capacity - Start);
+
+        Spill.resize(Length);
+        std::copy_n(Buffer.get() + Start, First, Spill.data());
+        std::copy_n(Buffer.get(), Buffered - First, Spill.data() + First);
+        SpillFilled = Buffered;
+        Head += Buffered;
+
+        bSpilling = true;
+        return NextFrame(OutFrame);
+    }
+
+    if (Used < ControlFrameHeaderBytes + Length)
+        return false;
+
+    std::size_t Start = static_cast<std::size_t>((Head + ControlFrameHeaderBytes) & Mask);
+    if (Start + Length <= Capacity)
+    {
+        OutFrame = std::string_view(Buffer.get() + Start, Length);
+    }
+    else
+    {
+        std::size_t First = Capacity - Start;
+        Scratch.assign(Buffer.get() + Start, First);
+        Scratch.append(Buffer.get(), Length - First);
+        OutFrame = Scratch;
+    }
+
+    Head += ControlFrameHeaderBytes + Length;
+    return true;
+}
+
+// ------------------------------------
+// Command tokenizer
+// ------------------------------------
+
+std::string_view CommandReader::Word()
+{
+    std::size_t Begin = Text.find_first_not_of(" \t\r\n");
+    if (Begin == std::string_view::npos)
+    {
+        Text = {};
+        return {};
+    }
+
+    std::size_t End = Text.find_first_of(" \t\r\n", Begin);
+    if (End == std::string_view::npos)
+        End = Text.size();
+
+    std::string_view Result = Text.substr(Begin, End - Begin);
+    Text.remove_prefix(End);
+    return Result;
+}
+
+CommandReader& CommandReader::operator>>(std::string_view& Out)
+{
+    Out = Word();
+    bOk = bOk && !Out.empty();
+    return *this;
+}
+
+CommandReader& CommandReader::operator>>(std::string& Out)
+{
+    std::string_view Token = Word();
+    bOk = bOk && !Token.empty();
+    if (!Token.empty())
+        Out.assign(Token);
+    return *this;
+}
+
+template <typename T>
+CommandReader& CommandReader::ReadNumber(T& Out)
+{
+    std::string_view Token = Word();
+    auto [Ptr, Ec] = std::from_chars(Token.data(), Token.data() + Token.size(), Out);
+    bOk = bOk && !Token.empty() && Ec == std::errc() && Ptr == Token.data() + Token.size();
+    return *this;
+}
+
+CommandReader& CommandReader::operator>>(uint64_t& Out) { return ReadNumber(Out); }
+CommandReader& CommandReader::operator>>(int64_t& Out) { return ReadNumber(Out); }
+CommandReader& CommandReader::operator>>(uint32_t& Out) { return ReadNumber(Out); }
+CommandReader& CommandReader::operator>>(int& Out) { return ReadNumber(Out); }
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/** 제어 메시지 프레임
+    구조: [길이(4, big-endian)] + [명령 문자열...]
+    TCP 세그먼트가 합쳐지거나 나뉘어 와도 메시지 경계를 복원할 수 있음
+*/
+constexpr std::size_t ControlFrameHeaderBytes = 4;
+
+/** 명령 문자열을 프레임으로 감쌈
+    @input Payload 명령 문자열
+    @return 길이 헤더가 붙은 프레임
+*/
+std::string EncodeControlFrame(std::string_view Payload);
+
+/** 세션별 수신 링 버퍼 + 증분 프레임 파서
+    - 한 번의 읽기에 여러 명령이 들어 있으면 한 번에 모두 꺼냄 (파이프라이닝)
+    - 프레임이 반쯤만 도착했으면 다음 읽기까지 남겨 둠
+    - 꺼낸 프레임은 버퍼를 직접 가리키는 string_view (링 끝에서 감긴 프레임만 복사)
+    - 링보다 긴 프레임(긴 구간 목록 등)은 MaxFrameBytes 까지 힙 버퍼로 따로 받음
+*/
+class ControlFrameReader
+{
+public:
+    /** ReadFrom 결과 */
+    enum class EReadResult : uint8_t
+    {
+        Drained,  // 소켓에 읽을 데이터가 더 없음
+        Full,     // 버퍼가 가득 참 (프레임을 꺼낸 뒤 다시 읽어야 함)
+        Closed,   // 연결 종료 또는 소켓 오류
+    };
+
+    /** 링 버퍼 크기 (2의 거듭제곱) */
+    static constexpr std::size_t Capacity = 64 * 1024;
+
+    /** 링에 그대로 담기는 최대 명령 길이 (넘으면 힙 버퍼로 받음) */
+    static constexpr std::size_t MaxRingFrameBytes = Capacity - ControlFrameHeaderBytes;
+
+    /** 허용하는 최대 명령 길이 (넘으면 프로토콜 오류)
+        FILE_RESEND / FANOUT_NACK / FILE_HAVE 의 구간 목록이 수십만 구간이어도 들어가는 크기
+    */
+    static constexpr std::size_t MaxFrameBytes = 16 * 1024 * 1024;
+
+    ControlFrameReader();
+
+    /** 소켓에서 읽을 수 있는 만큼 링 버퍼로 읽음 (블로킹하지 않음)
+        @input Socket 읽을 소켓
+        @return 읽기 상태
+    */
+    EReadResult ReadFrom(int Socket);
+
+    /** 완성된 프레임 하나를 꺼냄
+        @input OutFrame 명령 문자열 (다음 ReadFrom 전까지만 유효)
+        @return 꺼냈으면 true, 아직 완성된 프레임이 없으면 false
+    */
+    bool NextFrame(std::string_view& OutFrame);
+
+    /** 너무 긴 프레임 등 프로토콜 오류 여부 (세션을 닫아야 함) */
+    bool HasError() const { return bError; }
+
+private:
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    std::unique_ptr<char[]> Buffer;
+
+    /** 누적 읽기/쓰기 위치 (Mask 로 버퍼 위치를 구함) */
+    uint64_t Head = 0;
+    uint64_t Tail = 0;
+
+    /** 링 끝에서 감긴 프레임을 이어 붙이는 버퍼 */
+    std::string Scratch;
+
+    /** 링보다 긴 프레임을 받는 버퍼 (프레임 길이만큼 잡고, 꺼낸 뒤 다음 ReadFrom 에서 놓음) */
+    std::string Spill;
+
+    /** Spill 에 지금까지 받은 바이트 수 */
+    std::size_t SpillFilled = 0;
+
+    /** 긴 프레임을 받는 중이거나 아직 꺼내지 않았는지 여부 */
+    bool bSpilling = false;
+
+    /** 긴 프레임의 나머지를 소켓에서 Spill 로 읽음
+        @input Socket 읽을 소켓
+        @return 다 받았으면 Full (링으로 계속 읽음), 아니면 Drained / Closed
+    */
+    EReadResult ReadSpill(int Socket);
+
+    bool bError = false;
+};
+
+/** 명령 문자열을 공백 단위로 읽는 파서
+    istringstream 과 같은 방식(>>)으로 쓰지만 할당/로케일 처리 없이 원본을 그대로 잘라 읽음
+*/
+class CommandReader
+{
+public:
+    explicit CommandReader(std::string_view InText)
+        : Text(InText)
+    {
+    }
+
+    /** 다음 단어 (없으면 빈 문자열) */
+    std::string_view Word();
+
+    CommandReader& operator>>(std::string_view& Out);
+    CommandReader& operator>>(std::string& Out);
+    CommandReader& operator>>(uint64_t& Out);
+    CommandReader& operator>>(int64_t& Out);
+    CommandReader& operator>>(uint32_t& Out);
+    CommandReader& operator>>(int& Out);
+
+    /** 지금까지 읽기가 모두 성공했는지 여부 */
+    explicit operator bool() const { return bOk; }
+
+private:
+    template <typename T>
+    CommandReader& ReadNumber(T& Out);
+
+    std::string_view Text;
+    bool bOk = true;
+};
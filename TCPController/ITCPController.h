@@ -25,10 +25,10 @@ public:
     virtual ISession* CreateSession(int32 ConnectionId) = 0;
 
     /** 특정 세션에 메시지 전송
-        @input SessionId 대상 세션 아이디
+        @input SessionId 대상 세션 핸들 (이미 끊긴 세션이면 무시)
         @input Message 전송할 메시지
     */
-    virtual void SendToSession(int32 SessionId, const std::string& Message) = 0;
+    virtual void SendToSession(uint64_t SessionId, const std::string& Message) = 0;
 
     /** 전체 세션에 메시지 전송 (브로드캐스트)
         @input Message 전송할 메시지
@@ -0,0 +1,284 @@
+#include "TCPController.h"
+#include "ControlFrame.h"
+#include "FileSplitterAndMerger.h"
+#include "MultiSourceScheduler.h"
+#include "UDPModel.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <thread>
+
+/**
+ * @brief 여러 서버에서 파일 하나를 나눠 받는 루프백 데모 (FILE_RANGE / FILE_RANGE_CANCEL)
+ *
+ * 1. 16 MiB 테스트 파일을 만들고, 같은 프로세스에 서버를 포트만 달리해서 여러 개 띄운다.
+ * 2. 첫 번째 서버는 ADMIN 인증 뒤 SEND_RATE 로 느리게 만든다. (느린 서버 흉내)
+ * 3. 클라이언트는 MultiSourceScheduler 로 서버마다 구간을 요청하고, 모든 데이터그램을
+ *    UDPModel 세션 하나에 넣는다. 나눠 줄 구간이 떨어지면 느린 서버 몫의 뒷부분을
+ *    빠른 서버가 가져가고, 느린 서버에는 FILE_RANGE_CANCEL 을 보낸다.
+ * 4. 다 받으면 다이제스트(FILE_RANGE_DONE 값)와 합친 파일 내용을 원본과 비교한다.
+ *
+ * 사용법: MultiSourcemain [servers] [slow_bytes_per_sec]   (기본 3 1048576)
+ */
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint16_t BASE_PORT = 7801;
+constexpr uint64_t FILE_BYTES = 16ull << 20;
+constexpr uint64_t TRANSFER_ID = 0x5EED;
+constexpr const char* ADMIN_TOKEN = "multi-source-demo";
+constexpr const char* IN_PATH = "multi_source_in.bin";
+constexpr const char* OUT_PATH = "multi_source_out.bin";
+
+// 서버 하나와의 TCP 연결
+struct Source {
+    int socket = -1;
+    ControlFrameReader inbox;
+};
+
+void SendFrame(const Source& source, const std::string& message)
+{
+    std::string frame = EncodeControlFrame(message);
+    send(source.socket, frame.data(), frame.size(), MSG_NOSIGNAL);
+}
+
+// 다음 명령 하나를 기다린다 (timeoutMs 안에 없으면 빈 문자열)
+std::string WaitFrame(Source& source, int timeoutMs)
+{
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true) {
+        std::string_view frame;
+        if (source.inbox.NextFrame(frame))
+            return std::string(frame);
+
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (left <= 0)
+            return {};
+
+        pollfd pfd{source.socket, POLLIN, 0};
+        poll(&pfd, 1, static_cast<int>(left));
+        if (source.inbox.ReadFrom(source.socket) == ControlFrameReader::EReadResult::Closed)
+            return {};
+    }
+}
+
+bool Connect(Source& source, uint16_t port)
+{
+    source.socket = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (connect(source.socket, (sockaddr*)&addr, sizeof(addr)) < 0)
+        return false;
+
+    fcntl(source.socket, F_SETFL, fcntl(source.socket, F_GETFL) | O_NONBLOCK);
+
+    // SESSION <handle>
+    return WaitFrame(source, 1000).starts_with("SESSION ");
+}
+
+// 명령의 마지막 토큰 (FILE_RANGE_DONE 의 다이제스트)
+uint32_t LastNumber(const std::string& message)
+{
+    return static_cast<uint32_t>(std::strtoul(message.substr(message.rfind(' ') + 1).c_str(), nullptr, 10));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t serverCount = argc > 1 ? std::max(std::atoi(argv[1]), 2) : 3;
+    uint64_t slowRate = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1048576;
+
+    // ============================================================
+    // 1) 테스트 파일 (중간에 0 구간을 넣어 0 구간 표식 취소도 거치게 함)
+    // ============================================================
+    std::vector<char> original(FILE_BYTES);
+    {
+        std::mt19937 rng(11);
+        for (uint64_t i = 0; i < FILE_BYTES; ++i)
+            original[i] = (i >= FILE_BYTES * 3 / 4 && i < FILE_BYTES * 7 / 8) ? 0 : static_cast<char>(rng());
+        std::ofstream f(IN_PATH, std::ios::binary);
+        f.write(original.data(), original.size());
+    }
+
+    // ============================================================
+    // 2) 서버 여러 개 (포트만 다름), 각자 스레드에서 리액터를 돌림
+    // ============================================================
+    std::vector<std::unique_ptr<TCPController>> servers;
+    for (std::size_t i = 0; i < serverCount; ++i) {
+        servers.push_back(std::make_unique<TCPController>(static_cast<uint16_t>(BASE_PORT + i)));
+        servers.back()->SetAdminToken(ADMIN_TOKEN);
+        if (!servers.back()->Init()) {
+            std::cout << "server " << i << " init failed (port " << BASE_PORT + i << ")\n";
+            return 1;
+        }
+    }
+
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (auto& server : servers) {
+        threads.emplace_back([&running, srv = server.get()] {
+            while (running) {
+                srv->Update();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+
+    // ============================================================
+    // 3) 클라이언트: UDP 수신 소켓 하나 + 서버마다 TCP 연결
+    // ============================================================
+    int udp = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in udpAddr{};
+    udpAddr.sin_family = AF_INET;
+    udpAddr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    bind(udp, (sockaddr*)&udpAddr, sizeof(udpAddr));
+    socklen_t udpAddrLen = sizeof(udpAddr);
+    getsockname(udp, (sockaddr*)&udpAddr, &udpAddrLen);
+    int rcvbuf = 8 << 20;
+    setsockopt(udp, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    fcntl(udp, F_SETFL, fcntl(udp, F_GETFL) | O_NONBLOCK);
+
+    std::vector<std::unique_ptr<Source>> sources;
+    for (std::size_t i = 0; i < serverCount; ++i) {
+        sources.push_back(std::make_unique<Source>());
+        if (!Connect(*sources.back(), static_cast<uint16_t>(BASE_PORT + i))) {
+            std::cout << "connect to server " << i << " failed\n";
+            return 1;
+        }
+    }
+
+    // 첫 번째 서버만 느리게 (전역 송신 속도는 관리 명령)
+    SendFrame(*sources[0], std::string("ADMIN ") + ADMIN_TOKEN);
+    if (WaitFrame(*sources[0], 1000) != "ADMIN OK") {
+        std::cout << "admin login failed\n";
+        return 1;
+    }
+    SendFrame(*sources[0], "SEND_RATE " + std::to_string(slowRate));
+
+    // 빈 구간 요청으로 파일 정보만 받는다: FILE_INFO <total> <size> <mtime> <chunk>
+    const std::string requestPrefix = std::string("FILE_RANGE ") + IN_PATH + " 127.0.0.1 "
+                                      + std::to_string(ntohs(udpAddr.sin_port)) + " " + std::to_string(TRANSFER_ID) + " ";
+    SendFrame(*sources[0], requestPrefix);
+    std::string info = WaitFrame(*sources[0], 5000);
+    if (!info.starts_with("FILE_INFO ") || !WaitFrame(*sources[0], 5000).starts_with("FILE_RANGE_DONE ")) {
+        std::cout << "no FILE_INFO\n";
+        return 1;
+    }
+    uint64_t totalPackets = std::strtoull(info.c_str() + 10, nullptr, 10);
+
+    UDPModel model;
+    model.InitializeSession(TRANSFER_ID, totalPackets, OUT_PATH);
+    MultiSourceScheduler scheduler(model, totalPackets, serverCount);
+
+    std::cout << "servers " << serverCount << " (server 0 at " << slowRate << " B/s), chunks " << totalPackets << "\n";
+
+    // ============================================================
+    // 4) 받기: 쉬는 서버에 구간 요청 -> 옮긴 구간 취소 -> UDP 처리 -> 완료 알림 처리
+    // ============================================================
+    std::vector<uint64_t> requests(serverCount, 0);
+    uint64_t cancels = 0, datagrams = 0, mismatchedInfo = 0;
+    uint32_t serverDigest = 0;
+    auto start = Clock::now();
+
+    std::vector<pollfd> pfds;
+    pfds.push_back({udp, POLLIN, 0});
+    for (auto& source : sources)
+        pfds.push_back({source->socket, POLLIN, 0});
+
+    while (!model.IsSessionComplete() && Clock::now() - start < std::chrono::seconds(60)) {
+        auto now = Clock::now();
+
+        for (std::size_t s = 0; s < serverCount; ++s) {
+            PacketRange range;
+            if (scheduler.NextRange(s, now, range) == 1) {
+                SendFrame(*sources[s], requestPrefix + FormatPacketRanges({range}));
+                ++requests[s];
+            }
+        }
+
+        for (const auto& cancel : scheduler.TakeCancelledRanges()) {
+            SendFrame(*sources[cancel.source],
+                      "FILE_RANGE_CANCEL " + std::to_string(TRANSFER_ID) + " " + FormatPacketRanges({cancel.range}));
+            ++cancels;
+        }
+
+        poll(pfds.data(), pfds.size(), 5);
+
+        // UDP 를 먼저 비워야 완료 알림을 처리할 때 앞서 온 청크가 반영되어 있다
+        unsigned char buffer[2048];
+        ssize_t n;
+        while ((n = recv(udp, buffer, sizeof(buffer), 0)) > 0) {
+            model.ProcessReceivedPacket(buffer, static_cast<int>(n));
+            ++datagrams;
+        }
+        model.TakeAckRanges(); // 구간 요청은 ACK 를 쓰지 않음
+
+        for (std::size_t s = 0; s < serverCount; ++s) {
+            Source& source = *sources[s];
+            source.inbox.ReadFrom(source.socket);
+
+            std::string_view frame;
+            while (source.inbox.NextFrame(frame)) {
+                if (frame.starts_with("FILE_RANGE_DONE ")) {
+                    serverDigest = LastNumber(std::string(frame));
+                    scheduler.OnRangeDone(s, Clock::now());
+                } else if (frame.starts_with("FILE_INFO ") && frame != info) {
+                    ++mismatchedInfo; // 서버마다 파일이 다름
+                }
+            }
+        }
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // ============================================================
+    // 5) 결과 확인
+    // ============================================================
+    bool complete = model.IsSessionComplete();
+    bool digestOk = complete && model.GetFileDigest() == serverDigest;
+
+    bool fileOk = false;
+    std::vector<Packet> packets;
+    FileSplitterAndMerger fsm;
+    if (complete && model.ExportPackets(packets) == 1 && fsm.MergeFile(OUT_PATH, packets)) {
+        std::ifstream f(OUT_PATH, std::ios::binary);
+        std::vector<char> merged((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        fileOk = merged == original;
+    }
+
+    for (std::size_t s = 0; s < serverCount; ++s) {
+        std::cout << "server " << s << ": " << requests[s] << " ranges, "
+                  << scheduler.GetThroughput(s) << " packets/s\n";
+    }
+    std::cout << "datagrams " << datagrams << ", cancels " << cancels << ", " << elapsedMs << " ms\n";
+    std::cout << "complete " << complete << " digest " << (digestOk ? "ok" : "MISMATCH")
+              << " file " << (fileOk ? "equal" : "DIFFERENT")
+              << (mismatchedInfo ? " (servers disagree on FILE_INFO)" : "") << "\n";
+
+    running = false;
+    for (auto& thread : threads)
+        thread.join();
+    for (auto& source : sources)
+        close(source->socket);
+    close(udp);
+    for (auto& server : servers)
+        server->Shutdown();
+
+    return (complete && digestOk && fileOk) ? 0 : 1;
+}
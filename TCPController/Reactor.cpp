@@ -0,0 +1,253 @@
+#include "Reactor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// ------------------------------------
+// 생성자 / 소멸자
+// ------------------------------------
+
+Reactor::Reactor()
+    : Timers(0)
+    , Epoch(Clock::now())
+{
+}
+
+Reactor::~Reactor()
+{
+    Shutdown();
+}
+
+bool Reactor::Init()
+{
+    EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    return EpollFd >= 0;
+}
+
+void Reactor::Shutdown()
+{
+    /** Suspended frames are destroyed in place; nothing is resumed during teardown */
+
+    for (void* Address : Tasks)
+        std::coroutine_handle<>::from_address(Address).destroy();
+    Tasks.clear();
+
+    Ready.clear();
+    Fds.clear();
+    Timers = TimerWheel(NowTick());
+
+    if (EpollFd != -1)
+    {
+        close(EpollFd);
+        EpollFd = -1;
+    }
+    bRunning = false;
+}
+
+// ------------------------------------
+// Tasks / Sockets
+// ------------------------------------
+
+void Reactor::Spawn(Task NewTask)
+{
+    std::coroutine_handle<> Handle = NewTask.Handle;
+    NewTask.Handle = nullptr;
+
+    Tasks.insert(Handle.address());
+    Ready.push_back(Handle);
+}
+
+bool Reactor::Register(int Fd)
+{
+    epoll_event Event{};
+    Event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    Event.data.fd = Fd;
+
+    if (epoll_ctl(EpollFd, EPOLL_CTL_ADD, Fd, &Event) < 0)
+        return false;
+
+    Fds[Fd] = FdState{};
+    return true;
+}
+
+void Reactor::Unregister(int Fd)
+{
+    auto It = Fds.find(Fd);
+    if (It == Fds.end())
+        return;
+
+    epoll_ctl(EpollFd, EPOLL_CTL_DEL, Fd, nullptr);
+
+    if (IoAwaiter* Waiter = It->second.Waiter)
+    {
+        Waiter->Result = EPOLLHUP;
+        Ready.push_back(Waiter->Handle);
+    }
+    Fds.erase(It);
+}
+
+void Reactor::Resume(std::coroutine_handle<> Handle)
+{
+    Handle.resume();
+
+    if (Handle.done())
+    {
+        Tasks.erase(Handle.address());
+        Handle.destroy();
+    }
+}
+
+uint64_t Reactor::NowTick() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - Epoch).count();
+}
+
+// ------------------------------------
+// Event loop
+// ------------------------------------
+
+int Reactor::RunOnce(int TimeoutMs)
+{
+    /** Never block while something is runnable; with timers armed, block no longer than the earliest one */
+
+    if (!Ready.empty())
+    {
+        TimeoutMs = 0;
+    }
+    else if (Timers.Size() > 0)
+    {
+        uint64_t Now = NowTick();
+        uint64_t Next = Timers.NextExpiryTick();
+        int UntilNext = Next > Now ? static_cast<int>(std::min<uint64_t>(Next - Now, INT_MAX)) : 0;
+        if (TimeoutMs < 0 || TimeoutMs > UntilNext)
+            TimeoutMs = UntilNext;
+    }
+
+    epoll_event Events[MaxEvents];
+    int Count = epoll_wait(EpollFd, Events, MaxEvents, TimeoutMs);
+    if (Count < 0 && errno != EINTR)
+        return -1;
+
+    for (int i = 0; i < Count; ++i)
+    {
+        auto It = Fds.find(Events[i].data.fd);
+        if (It == Fds.end())
+            continue;
+
+        FdState& State = It->second;
+        State.Pending |= Events[i].events;
+
+        if (IoAwaiter* Waiter = State.Waiter)
+        {
+            Waiter->Result = State.Pending;
+            State.Pending = 0;
+            State.Waiter = nullptr;
+            Ready.push_back(Waiter->Handle);
+        }
+    }
+
+    std::vector<uint64_t> Expired;
+    Timers.Advance(NowTick(), Expired);
+    for (uint64_t Address : Expired)
+        Ready.push_back(std::coroutine_handle<>::from_address(reinterpret_cast<void*>(Address)));
+
+    // Tasks that yield now land in the next round, not this one
+    std::vector<std::coroutine_handle<>> Runnable;
+    Runnable.swap(Ready);
+    for (std::coroutine_handle<> Handle : Runnable)
+        Resume(Handle);
+
+    return static_cast<int>(Runnable.size());
+}
+
+void Reactor::Run()
+{
+    bRunning = true;
+    while (bRunning && EpollFd != -1)
+        RunOnce(100);
+}
+
+// ------------------------------------
+// Awaiters
+// ------------------------------------
+
+bool Reactor::IoAwaiter::await_ready()
+{
+    /** Edges that arrived while nobody was waiting are consumed without suspending */
+
+    auto It = Owner.Fds.find(Fd);
+    if (It == Owner.Fds.end())
+    {
+        Result = EPOLLHUP;
+        return true;
+    }
+
+    if (It->second.Pending == 0)
+        return false;
+
+    Result = It->second.Pending;
+    It->second.Pending = 0;
+    return true;
+}
+
+void Reactor::IoAwaiter::await_suspend(std::coroutine_handle<> InHandle)
+{
+    Handle = InHandle;
+    Owner.Fds[Fd].Waiter = this;
+}
+
+void Reactor::SleepAwaiter::await_suspend(std::coroutine_handle<> InHandle)
+{
+    Owner.Timers.Schedule(Owner.NowTick() + Ms, reinterpret_cast<uint64_t>(InHandle.address()));
+}
+
+void Reactor::YieldAwaiter::await_suspend(std::coroutine_handle<> InHandle)
+{
+    Owner.Ready.push_back(InHandle);
+}
+
+bool Reactor::WakeSignal::Awaiter::await_ready()
+{
+    if (!Signal.bNotified)
+        return false;
+
+    Signal.bNotified = false;
+    return true;
+}
+
+void Reactor::WakeSignal::Awaiter::await_suspend(std::coroutine_handle<> InHandle)
+{
+    Signal.Waiter = InHandle;
+
+    if (TimeoutMs != NoTimeout)
+        Signal.Timeout = Signal.Owner.Timers.Schedule(Signal.Owner.NowTick() + TimeoutMs,
+                                                      reinterpret_cast<uint64_t>(InHandle.address()));
+}
+
+void Reactor::WakeSignal::Awaiter::await_resume()
+{
+    /** Woken by the timeout: stop being the waiter so a later Notify is remembered instead */
+
+    Signal.Waiter = nullptr;
+    Signal.Timeout = TimerWheel::INVALID_TIMER;
+}
+
+void Reactor::WakeSignal::Notify()
+{
+    if (Waiter)
+    {
+        // An expired timeout has already queued the waiter
+        if (Timeout == TimerWheel::INVALID_TIMER || Owner.Timers.Cancel(Timeout))
+            Owner.Ready.push_back(Waiter);
+
+        Waiter = nullptr;
+        Timeout = TimerWheel::INVALID_TIMER;
+    }
+    else
+    {
+        bNotified = true;
+    }
+}
@@ -0,0 +1,221 @@
+#pragma once
+#include "TimerWheel.h"
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Reactor;
+
+/** 리액터가 실행하는 코루틴 작업 (Reactor::Spawn 으로 넘기면 끝날 때 리액터가 정리)
+    다른 Task 를 co_await 하지 않는 최상위 작업 전용
+    - 세션 하나 = Task 하나 (스레드 없이 수만 개를 동시에 유지)
+*/
+class Task
+{
+public:
+    struct promise_type
+    {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task(Task&& Other) noexcept
+        : Handle(Other.Handle)
+    {
+        Other.Handle = nullptr;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (Handle)
+            Handle.destroy();
+    }
+
+private:
+    friend class Reactor;
+
+    explicit Task(std::coroutine_handle<promise_type> InHandle)
+        : Handle(InHandle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> Handle;
+};
+
+/** epoll 기반 단일 스레드 이벤트 루프
+    - 소켓 준비(WaitIo), 시간 지연(Sleep), 양보(Yield), 신호(WakeSignal)를 co_await 로 기다림
+    - 소켓은 edge-triggered 로 한 번만 등록 (기다릴 때마다 epoll_ctl 을 부르지 않음)
+    - 시간 지연은 계층형 타이머 휠 (1틱 = 1ms)
+*/
+class Reactor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** 소켓 준비 대기
+        결과: 발생한 epoll 이벤트 (EPOLLIN / EPOLLOUT / EPOLLHUP ...)
+        edge-triggered 이므로 읽기/쓰기가 EAGAIN 을 낸 뒤에만 기다려야 함
+    */
+    struct IoAwaiter
+    {
+        Reactor& Owner;
+        int Fd;
+        uint32_t Result = 0;
+        std::coroutine_handle<> Handle{};
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> InHandle);
+        uint32_t await_resume() const { return Result; }
+    };
+
+    /** 시간 지연 대기 */
+    struct SleepAwaiter
+    {
+        Reactor& Owner;
+        uint64_t Ms;
+
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> InHandle);
+        void await_resume() const {}
+    };
+
+    /** 다른 작업에 차례를 넘김 (다음 RunOnce 에서 재개) */
+    struct YieldAwaiter
+    {
+        Reactor& Owner;
+
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> InHandle);
+        void await_resume() const {}
+    };
+
+    /** 작업 하나가 기다리는 깨우기 신호
+        기다리는 작업이 없을 때 Notify 하면 다음 Wait 가 바로 통과
+        WaitFor 는 신호가 없어도 시간이 지나면 깨어남
+    */
+    class WakeSignal
+    {
+    public:
+        explicit WakeSignal(Reactor& InOwner)
+            : Owner(InOwner)
+        {
+        }
+
+        /** 시간 제한 없음 */
+        static constexpr uint64_t NoTimeout = UINT64_MAX;
+
+        struct Awaiter
+        {
+            WakeSignal& Signal;
+            uint64_t TimeoutMs = NoTimeout;
+
+            bool await_ready();
+            void await_suspend(std::coroutine_handle<> InHandle);
+            void await_resume();
+        };
+
+        /** 기다리는 작업을 깨움 (시간 초과로 이미 깨어날 차례면 다시 넣지 않음) */
+        void Notify();
+
+        /** 신호가 올 때까지 대기 */
+        Awaiter Wait() { return Awaiter{*this}; }
+
+        /** 신호가 오거나 Ms 가 지날 때까지 대기 */
+        Awaiter WaitFor(uint64_t Ms) { return Awaiter{*this, Ms}; }
+
+    private:
+        Reactor& Owner;
+        std::coroutine_handle<> Waiter;
+        bool bNotified = false;
+
+        /** WaitFor 의 시간 초과 타이머 (Notify 가 먼저 오면 취소) */
+        TimerWheel::TimerId Timeout = TimerWheel::INVALID_TIMER;
+    };
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /** epoll 생성
+        @return 성공 시 true
+    */
+    bool Init();
+
+    /** 남은 작업을 모두 정리하고 epoll 을 닫음 (작업은 재개하지 않고 그대로 해제) */
+    void Shutdown();
+
+    /** 작업 시작 (다음 RunOnce 에서 처음 실행) */
+    void Spawn(Task NewTask);
+
+    /** 소켓을 edge-triggered 로 등록 (읽기 / 쓰기 / 끊김)
+        @return 성공 시 true
+    */
+    bool Register(int Fd);
+
+    /** 소켓 등록 해제 (close 전에 호출)
+        기다리던 작업은 EPOLLHUP 결과로 깨어남
+    */
+    void Unregister(int Fd);
+
+    IoAwaiter WaitIo(int Fd) { return IoAwaiter{*this, Fd}; }
+    SleepAwaiter Sleep(uint64_t Ms) { return SleepAwaiter{*this, Ms}; }
+    YieldAwaiter Yield() { return YieldAwaiter{*this}; }
+
+    /** 준비된 이벤트 / 만료된 타이머 / 양보한 작업을 한 번 처리
+        @input TimeoutMs 처리할 것이 없을 때 기다릴 최대 시간 (0이면 기다리지 않음)
+        @return 재개한 작업 수
+    */
+    int RunOnce(int TimeoutMs);
+
+    /** Stop 이 불릴 때까지 RunOnce 반복 */
+    void Run();
+
+    /** Run 종료 요청 */
+    void Stop() { bRunning = false; }
+
+private:
+    /** 등록된 소켓 상태 */
+    struct FdState
+    {
+        /** 기다리는 작업이 없을 때 도착한 이벤트 */
+        uint32_t Pending = 0;
+
+        /** 이 소켓을 기다리는 작업 (소켓당 하나) */
+        IoAwaiter* Waiter = nullptr;
+    };
+
+    /** 작업 재개, 끝났으면 해제 */
+    void Resume(std::coroutine_handle<> Handle);
+
+    uint64_t NowTick() const;
+
+    int EpollFd = -1;
+    bool bRunning = false;
+
+    std::unordered_map<int, FdState> Fds;
+
+    /** 다음 RunOnce 에서 재개할 작업 */
+    std::vector<std::coroutine_handle<>> Ready;
+
+    /** 실행 중인 작업 (Shutdown 때 해제) */
+    std::unordered_set<void*> Tasks;
+
+    /** Sleep 타이머 (userData = 코루틴 프레임 주소) */
+    TimerWheel Timers;
+    Clock::time_point Epoch;
+
+    /** epoll_wait 한 번에 받는 최대 이벤트 수 */
+    static constexpr int MaxEvents = 256;
+};
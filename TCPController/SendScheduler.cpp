@@ -0,0 +1,323 @@
+#include "SendScheduler.h"
+
+#include <algorithm>
+
+// ------------------------------------
+// Queueing
+// ------------------------------------
+
+void SendScheduler::Enqueue(ESendClass Class, SendItem Item)
+{
+    /** Append to the flow's queue; the flow joins the class round robin if it was idle */
+
+    std::size_t C = static_cast<std::size_t>(Class);
+
+    Item.Enqueued = Clock::now();
+
+    Flow& FlowObj = Flows[Item.FlowId];
+    if (!FlowObj.Active[C] && !FlowObj.Blocked[C])
+    {
+        FlowObj.Active[C] = true;
+        FlowObj.Deficit[C] = 0;
+        ActiveFlows[C].push_back(Item.FlowId);
+    }
+    FlowObj.Queue[C].push_back(std::move(Item));
+
+    ++Metrics[C].QueueDepth;
+    ++Metrics[C].Enqueued;
+}
+
+bool SendScheduler::Dequeue(Clock::time_point Now, SendItem& OutItem)
+{
+    /** Strict priority between classes, weighted DRR between flows inside a class */
+
+    Refill(Now);
+
+    for (std::size_t C = 0; C < ClassCount; ++C)
+    {
+        auto& Ring = ActiveFlows[C];
+        while (!Ring.empty())
+        {
+            uint64_t FlowId = Ring.front();
+            Flow& FlowObj = Flows[FlowId];
+            auto& Queue = FlowObj.Queue[C];
+
+            /** Receiver window closed: park new data until SetFlowWindow opens it.
+                Resends are not in index order, so one beyond the window would block the
+                repairs behind it; drop it instead (the receiver NACKs it once its window gets there) */
+            if (IsOutsideWindow(Queue.front()))
+            {
+                if (static_cast<ESendClass>(C) == ESendClass::Retransmit)
+                {
+                    Queue.pop_front();
+                    --Metrics[C].QueueDepth;
+                    if (Queue.empty())
+                        Retire(FlowId, C);
+                    continue;
+                }
+
+                FlowObj.Active[C] = false;
+                FlowObj.Blocked[C] = true;
+                Ring.pop_front();
+                continue;
+            }
+
+            std::size_t Cost = Queue.front().Bytes;
+
+            /** Out of credit for this round: top up and go to the back */
+            if (FlowObj.Deficit[C] < Cost)
+            {
+                auto WeightIt = Weights.find(FlowId);
+                uint32_t Weight = (WeightIt != Weights.end()) ? WeightIt->second : 1;
+                FlowObj.Deficit[C] += static_cast<uint64_t>(Weight) * BaseQuantum;
+                Ring.push_back(FlowId);
+                Ring.pop_front();
+                continue;
+            }
+
+            /** Global rate cap: leave everything queued until enough tokens accumulate */
+            if (RateBytesPerSecond > 0 && Tokens < static_cast<double>(Cost))
+                return false;
+
+            OutItem = std::move(Queue.front());
+            Queue.pop_front();
+            FlowObj.Deficit[C] -= Cost;
+            if (RateBytesPerSecond > 0)
+                Tokens -= static_cast<double>(Cost);
+
+            /** Metrics */
+            ClassMetrics& M = Metrics[C];
+            double LatencyUs = std::chrono::duration<double, std::micro>(Now - OutItem.Enqueued).count();
+            M.AvgLatencyUs = (M.Sent == 0) ? LatencyUs : M.AvgLatencyUs + LatencyAlpha * (LatencyUs - M.AvgLatencyUs);
+            M.MaxLatencyUs = std::max(M.MaxLatencyUs, LatencyUs);
+            --M.QueueDepth;
+            ++M.Sent;
+            M.SentBytes += Cost;
+
+            if (Queue.empty())
+                Retire(FlowId, C);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64_t SendScheduler::Cancel(uint64_t FlowId, uint64_t SessionId, const std::vector<PacketRange>& Ranges)
+{
+    /** Remove queued datagrams the receiver now expects from elsewhere; zero runs keep their uncovered pieces */
+
+    auto FlowIt = Flows.find(FlowId);
+    if (FlowIt == Flows.end() || Ranges.empty())
+        return 0;
+
+    std::vector<PacketRange> Sorted = Ranges;
+    std::sort(Sorted.begin(), Sorted.end(),
+              [](const PacketRange& A, const PacketRange& B) { return A.begin < B.begin; });
+
+    auto Covered = [&Sorted](uint64_t Index) {
+        return std::any_of(Sorted.begin(), Sorted.end(),
+                           [Index](const PacketRange& R) { return R.begin <= Index && Index < R.end; });
+    };
+
+    uint64_t Removed = 0;
+    Flow& FlowObj = FlowIt->second;
+    for (std::size_t C = 0; C < ClassCount; ++C)
+    {
+        auto& Queue = FlowObj.Queue[C];
+        std::deque<SendItem> Kept;
+
+        for (SendItem& Item : Queue)
+        {
+            bool Target = Item.SessionId == SessionId
+                          && (Item.Kind == SendItem::EKind::Data || Item.Kind == SendItem::EKind::ZeroRange);
+            if (!Target)
+            {
+                Kept.push_back(std::move(Item));
+            }
+            else if (Item.Kind == SendItem::EKind::Data)
+            {
+                if (Covered(Item.Index))
+                    ++Removed;
+                else
+                    Kept.push_back(std::move(Item));
+            }
+            else
+            {
+                // Zero run [Index, End): keep the gaps between cancelled ranges as separate markers
+                uint64_t Cursor = Item.Index;
+                for (const PacketRange& R : Sorted)
+                {
+                    if (R.end <= Cursor || R.begin >= Item.End)
+                        continue;
+
+                    if (R.begin > Cursor)
+                    {
+                        SendItem Piece = Item;
+                        Piece.Index = Cursor;
+                        Piece.End = R.begin;
+                        Kept.push_back(std::move(Piece));
+                    }
+
+                    uint64_t CutEnd = std::min(R.end, Item.End);
+                    Removed += CutEnd - std::max(R.begin, Cursor);
+                    Cursor = CutEnd;
+                }
+
+                if (Cursor < Item.End)
+                {
+                    Item.Index = Cursor;
+                    Kept.push_back(std::move(Item));
+                }
+            }
+        }
+
+        Metrics[C].QueueDepth = Metrics[C].QueueDepth + Kept.size() - Queue.size();
+        Queue.swap(Kept);
+
+        /** An emptied class leaves the round robin wherever it stands in it */
+        if (Queue.empty() && (FlowObj.Active[C] || FlowObj.Blocked[C]))
+        {
+            if (FlowObj.Active[C])
+                ActiveFlows[C].erase(std::find(ActiveFlows[C].begin(), ActiveFlows[C].end(), FlowId));
+
+            FlowObj.Active[C] = false;
+            FlowObj.Blocked[C] = false;
+            FlowObj.Deficit[C] = 0;
+        }
+    }
+
+    bool Idle = std::all_of(std::begin(FlowObj.Queue), std::end(FlowObj.Queue),
+                            [](const std::deque<SendItem>& Pending) { return Pending.empty(); });
+    if (Idle)
+        Flows.erase(FlowIt);
+    else
+        Unblock(FlowId);  // a parked head may have been cancelled
+
+    return Removed;
+}
+
+void SendScheduler::RemoveFlow(uint64_t FlowId)
+{
+    /** Nothing of a gone flow may still be sent or keep its settings around */
+
+    auto FlowIt = Flows.find(FlowId);
+    if (FlowIt != Flows.end())
+    {
+        Flow& FlowObj = FlowIt->second;
+        for (std::size_t C = 0; C < ClassCount; ++C)
+        {
+            Metrics[C].QueueDepth -= FlowObj.Queue[C].size();
+            if (FlowObj.Active[C])
+                ActiveFlows[C].erase(std::find(ActiveFlows[C].begin(), ActiveFlows[C].end(), FlowId));
+        }
+        Flows.erase(FlowIt);
+    }
+
+    Weights.erase(FlowId);
+    Windows.erase(FlowId);
+}
+
+// ------------------------------------
+// Configuration / Metrics
+// ------------------------------------
+
+void SendScheduler::SetWeight(uint64_t FlowId, uint32_t Weight)
+{
+    Weights[FlowId] = std::clamp<uint32_t>(Weight, 1, MaxWeight);
+}
+
+void SendScheduler::Retire(uint64_t FlowId, std::size_t C)
+{
+    /** Drained flows leave the round robin (they are at its front) and lose leftover credit */
+
+    Flow& FlowObj = Flows[FlowId];
+    FlowObj.Active[C] = false;
+    FlowObj.Deficit[C] = 0;
+    ActiveFlows[C].pop_front();
+
+    // A parked class still holds items, so the flow stays
+    bool Idle = std::all_of(std::begin(FlowObj.Queue), std::end(FlowObj.Queue),
+                            [](const std::deque<SendItem>& Pending) { return Pending.empty(); });
+    if (Idle)
+        Flows.erase(FlowId);
+}
+
+void SendScheduler::SetFlowWindow(uint64_t FlowId, uint64_t Limit)
+{
+    Windows[FlowId] = Limit;
+    Unblock(FlowId);
+}
+
+void SendScheduler::ClearFlowWindow(uint64_t FlowId)
+{
+    Windows.erase(FlowId);
+    Unblock(FlowId);
+}
+
+bool SendScheduler::IsOutsideWindow(const SendItem& Item) const
+{
+    if (Item.Kind != SendItem::EKind::Data && Item.Kind != SendItem::EKind::ZeroRange)
+        return false;
+
+    auto It = Windows.find(Item.FlowId);
+    return It != Windows.end() && Item.Index >= It->second;
+}
+
+void SendScheduler::Unblock(uint64_t FlowId)
+{
+    /** Parked queues rejoin the round robin once their head fits the window */
+
+    auto It = Flows.find(FlowId);
+    if (It == Flows.end())
+        return;
+
+    Flow& FlowObj = It->second;
+    for (std::size_t C = 0; C < ClassCount; ++C)
+    {
+        if (!FlowObj.Blocked[C] || IsOutsideWindow(FlowObj.Queue[C].front()))
+            continue;
+
+        FlowObj.Blocked[C] = false;
+        FlowObj.Active[C] = true;
+        FlowObj.Deficit[C] = 0;
+        ActiveFlows[C].push_back(FlowId);
+    }
+}
+
+void SendScheduler::SetRateLimit(uint64_t BytesPerSecond)
+{
+    RateBytesPerSecond = BytesPerSecond;
+    Tokens = 0.0;
+    LastRefill = Clock::now();
+}
+
+SendScheduler::ClassMetrics SendScheduler::GetMetrics(ESendClass Class) const
+{
+    return Metrics[static_cast<std::size_t>(Class)];
+}
+
+bool SendScheduler::IsEmpty() const
+{
+    return Flows.empty();
+}
+
+bool SendScheduler::HasRunnable() const
+{
+    return std::any_of(std::begin(ActiveFlows), std::end(ActiveFlows),
+                       [](const std::deque<uint64_t>& Ring) { return !Ring.empty(); });
+}
+
+void SendScheduler::Refill(Clock::time_point Now)
+{
+    /** Token bucket; burst is 10 ms of rate but never below two datagrams */
+
+    if (RateBytesPerSecond == 0)
+        return;
+
+    double Elapsed = std::chrono::duration<double>(Now - LastRefill).count();
+    LastRefill = Now;
+
+    double Burst = std::max(RateBytesPerSecond / 100.0, 2.0 * BaseQuantum);
+    Tokens = std::min(Burst, Tokens + Elapsed * static_cast<double>(RateBytesPerSecond));
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include "IFileSplitterAndMerger.h"
+#include "PacketRange.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <netinet/in.h>
+
+/** 전송 우선순위 클래스
+    숫자가 작은 클래스가 항상 먼저 나감 (재전송이 새 데이터보다 앞섬)
+*/
+enum class ESendClass : uint8_t
+{
+    Retransmit = 0,
+    Data = 1,
+    Count = 2,
+};
+
+/** 여러 곳(전송 캐시, 큐 항목)이 함께 가리키는 읽기 전용 패킷 목록 */
+using SharedPackets = std::shared_ptr<const std::vector<Packet>>;
+
+/** 스케줄러 큐에 들어가는 전송 단위
+    패킷 데이터는 복사하지 않고 전송 캐시의 패킷 목록을 공유해서 가리킴
+*/
+struct SendItem
+{
+    enum class EKind : uint8_t
+    {
+        Data,       // Packets[Index] 를 packet_index = Index 로 전송
+        ZeroRange,  // Packets[Index, End) 의 0 청크들을 구간 표식 하나로 전송
+        Parity,     // 패리티 Packets[Index] 를 packet_index = TotalPackets + seq 로 전송
+        Message,    // TCP 제어 메시지 (앞선 데이터 뒤에 순서대로 나가야 하는 완료 알림 등)
+    };
+
+    EKind Kind = EKind::Data;
+
+    /** DRR 흐름 아이디 (요청한 세션 / 팬아웃 채널) */
+    uint64_t FlowId = 0;
+
+    /** UDP 헤더에 실을 session_id */
+    uint64_t SessionId = 0;
+
+    SharedPackets Packets;
+    uint64_t Index = 0;
+    uint64_t End = 0;
+    uint64_t TotalPackets = 0;
+
+    /** 받을 UDP 주소 목록 (흐름 안의 항목들이 공유) */
+    std::shared_ptr<const std::vector<sockaddr_in>> Destinations;
+
+    /** Message 를 받을 세션 핸들과 내용 */
+    uint64_t TargetSession = 0;
+    std::string Text;
+
+    /** DRR / 속도 제한에 쓰는 바이트 수 (Message 는 0) */
+    std::size_t Bytes = 0;
+
+    /** 큐에 들어간 시각 (대기 시간 측정용) */
+    std::chrono::steady_clock::time_point Enqueued;
+};
+
+/** 동시에 진행 중인 전송들을 공정하게 섞어 내보내는 스케줄러
+    - 클래스 사이: 엄격한 우선순위 (Retransmit > Data)
+    - 클래스 안: 흐름별 가중치를 둔 DRR (Deficit Round Robin)
+    - 전체: 토큰 버킷으로 초당 송신 바이트 상한
+    - 흐름별 수신 창: 수신 측이 받을 수 없는 packet_index 는 창이 열릴 때까지 보류
+*/
+class SendScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** 클래스별 큐 상태 */
+    struct ClassMetrics
+    {
+        std::size_t QueueDepth = 0;
+        uint64_t Enqueued = 0;
+        uint64_t Sent = 0;
+        uint64_t SentBytes = 0;
+        double AvgLatencyUs = 0.0;  // 큐 대기 시간 이동 평균
+        double MaxLatencyUs = 0.0;
+    };
+
+    /** 전송 항목을 큐에 넣음
+        @input Class 우선순위 클래스
+        @input Item 전송 항목 (Enqueued 는 여기서 채움)
+    */
+    void Enqueue(ESendClass Class, SendItem Item);
+
+    /** 지금 보낼 다음 항목을 꺼냄
+        @input Now 현재 시각
+        @input OutItem 꺼낸 항목
+        @return 보낼 항목이 있으면 true, 큐가 비었거나 속도 제한에 걸리면 false
+    */
+    bool Dequeue(Clock::time_point Now, SendItem& OutItem);
+
+    /** 아직 나가지 않은 데이터 / 0 구간 항목 중 Ranges 에 든 packet_index 를 큐에서 지움
+        (클라이언트가 다른 서버로 옮긴 구간 요청의 취소, 0 구간 항목은 남는 부분만 잘라 둠)
+        @input FlowId 흐름 아이디
+        @input SessionId 지울 항목의 session_id (같은 흐름의 다른 전송은 그대로)
+        @input Ranges 지울 packet_index 구간 목록
+        @return 지운 패킷 수
+    */
+    uint64_t Cancel(uint64_t FlowId, uint64_t SessionId, const std::vector<PacketRange>& Ranges);
+
+    /** 흐름을 통째로 지움 (끊긴 세션, 수신자가 모두 떠난 팬아웃 채널)
+        모든 클래스의 남은 항목을 버리고 DRR 순번에서 빼며, 가중치 / 수신 창 설정도 지움
+        @input FlowId 흐름 아이디
+    */
+    void RemoveFlow(uint64_t FlowId);
+
+    /** 흐름 가중치 설정 (라운드마다 Weight * BaseQuantum 바이트씩 배분)
+        @input FlowId 흐름 아이디
+        @input Weight 가중치 (1 ~ MaxWeight 로 맞춤)
+    */
+    void SetWeight(uint64_t FlowId, uint32_t Weight);
+
+    /** 흐름의 수신 창 설정 (스트리밍 수신자의 재정렬 창)
+        packet_index >= Limit 인 데이터 / 0 구간 항목이 맨 앞에 오면 그 흐름은 창이 열릴 때까지 쉼
+        (뒤에 있는 완료 알림도 순서를 지키므로 함께 기다림)
+        재전송 클래스에서 창 밖 항목은 버림 (수신 측이 창에 들어온 뒤 다시 NACK)
+        @input FlowId 흐름 아이디
+        @input Limit 수신 측이 받을 수 있는 packet_index 상한 (이 값 미만까지 전송)
+    */
+    void SetFlowWindow(uint64_t FlowId, uint64_t Limit);
+
+    /** 흐름의 수신 창 해제 (보류 중인 항목은 다시 전송 순번에 들어감)
+        @input FlowId 흐름 아이디
+    */
+    void ClearFlowWindow(uint64_t FlowId);
+
+    /** 전체 송신 속도 상한 설정
+        @input BytesPerSecond 초당 바이트 (0이면 제한 없음)
+    */
+    void SetRateLimit(uint64_t BytesPerSecond);
+
+    /** 클래스별 큐 깊이 / 대기 시간 지표 */
+    ClassMetrics GetMetrics(ESendClass Class) const;
+
+    /** 모든 큐가 비었는지 여부 (창에 막혀 보류 중인 항목 포함) */
+    bool IsEmpty() const;
+
+    /** 지금 전송 순번에 있는 항목이 있는지 여부 (창에 막힌 흐름만 남았으면 false) */
+    bool HasRunnable() const;
+
+private:
+    static constexpr std::size_t ClassCount = static_cast<std::size_t>(ESendClass::Count);
+
+    struct Flow
+    {
+        std::deque<SendItem> Queue[ClassCount];
+        uint64_t Deficit[ClassCount] = {};
+        bool Active[ClassCount] = {};
+
+        /** 맨 앞 항목이 수신 창 밖이라 순번에서 빠져 있음 */
+        bool Blocked[ClassCount] = {};
+    };
+
+    /** 큐가 빈 클래스를 DRR 순번(맨 앞)에서 빼고, 모든 클래스가 비었으면 흐름 제거 */
+    void Retire(uint64_t FlowId, std::size_t C);
+
+    /** 항목이 흐름의 수신 창 밖인지 여부 (패리티 / 메시지는 창과 무관) */
+    bool IsOutsideWindow(const SendItem& Item) const;
+
+    /** 창에 막혔던 클래스 큐 중 다시 보낼 수 있는 것을 순번에 돌려놓음 */
+    void Unblock(uint64_t FlowId);
+
+    /** 토큰 버킷 충전 */
+    void Refill(Clock::time_point Now);
+
+    /** 가중치 1 흐름이 한 라운드에 받는 바이트 (최대 데이터그램보다 커야 함) */
+    static constexpr std::size_t BaseQuantum = 1500;
+
+    /** 흐름 하나가 가질 수 있는 최대 가중치 (한 세션이 대역을 독차지하지 못하도록) */
+    static constexpr uint32_t MaxWeight = 64;
+
+    /** 대기 시간 이동 평균 가중치 */
+    static constexpr double LatencyAlpha = 1.0 / 16;
+
+    /** 진행 중인 흐름 (큐가 모두 비면 제거) */
+    std::unordered_map<uint64_t, Flow> Flows;
+
+    /** 흐름별 가중치 (흐름이 비어도 유지) */
+    std::unordered_map<uint64_t, uint32_t> Weights;
+
+    /** 흐름별 수신 창 상한 (없으면 제한 없음) */
+    std::unordered_map<uint64_t, uint64_t> Windows;
+
+    /** 클래스별 DRR 순번 */
+    std::deque<uint64_t> ActiveFlows[ClassCount];
+
+    ClassMetrics Metrics[ClassCount];
+
+    /** 토큰 버킷 (RateBytesPerSecond == 0 이면 사용 안 함) */
+    uint64_t RateBytesPerSecond = 0;
+    double Tokens = 0.0;
+    Clock::time_point LastRefill{};
+};
@@ -1,10 +1,15 @@
 #include "Session.h"
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
 /** 생성자 */
-Session::Session(int32 InSessionId)
+Session::Session(SessionHandle InSessionId)
     : SessionId(InSessionId)
     , SocketHandle(-1)
+    , OutboxBytes(0)
+    , HighWaterMark(DefaultHighWaterMark)
+    , bAborted(false)
 {
 }
 /** 소멸자 */
@@ -13,18 +18,141 @@ Session::~Session()
     Close();
 }
 /** 세션 ID 반환 */
-int32 Session::GetId() const
+SessionHandle Session::GetId() const
 {
     return SessionId;
 }
 /** 메시지 전송 */
 void Session::Send(const std::string& Message)
 {
-    if (SocketHandle == -1)
+    SendShared(std::make_shared<const std::string>(EncodeControlFrame(Message)));
+}
+/** 공유 프레임 전송 */
+void Session::SendShared(const std::shared_ptr<const std::string>& Frame)
+{
+    if (SocketHandle == -1 || bAborted || Frame->empty())
+        return;
+
+    // Paced frames still waiting go first
+    if (!Paced.empty())
+    {
+        Paced.push_back(Frame);
+        Flush();
         return;
+    }
+
+    // Queue first so ordering holds even when earlier frames are still pending
+    Outbox.push_back({Frame, 0});
+    OutboxBytes += Frame->size();
 
-    // Send message to client socket
-    send(SocketHandle, Message.c_str(), Message.size(), 0);
+    // Client stopped reading: drop the connection instead of growing without bound
+    if (OutboxBytes > HighWaterMark * HardLimitFactor)
+    {
+        Abort();
+        return;
+    }
+
+    Flush();
+}
+/** 속도를 맞춘 전송 */
+void Session::SendPaced(const std::string& Message)
+{
+    if (SocketHandle == -1 || bAborted)
+        return;
+
+    Paced.push_back(std::make_shared<const std::string>(EncodeControlFrame(Message)));
+    Flush();
+}
+/** 송신 큐 비우기 */
+bool Session::Flush()
+{
+    while (SocketHandle != -1 && !bAborted)
+    {
+        // Admit paced frames only while below the high water mark, so they never reach the hard limit
+        while (!Paced.empty() && OutboxBytes < HighWaterMark)
+        {
+            OutboxBytes += Paced.front()->size();
+            Outbox.push_back({std::move(Paced.front()), 0});
+            Paced.pop_front();
+        }
+
+        if (Outbox.empty())
+            break;
+
+        // Gather queued buffers into one vectored write
+        iovec Iov[MaxIovecs];
+        int Count = 0;
+        for (auto It = Outbox.begin(); It != Outbox.end() && Count < MaxIovecs; ++It, ++Count)
+        {
+            Iov[Count].iov_base = const_cast<char*>(It->Buffer->data() + It->Offset);
+            Iov[Count].iov_len = It->Buffer->size() - It->Offset;
+        }
+
+        msghdr Msg{};
+        Msg.msg_iov = Iov;
+        Msg.msg_iovlen = Count;
+
+        ssize_t Sent = sendmsg(SocketHandle, &Msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (Sent < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return false;
+
+            Abort();
+            return false;
+        }
+
+        // Pop fully written buffers, keep the offset into a partially written one
+        std::size_t Remaining = static_cast<std::size_t>(Sent);
+        OutboxBytes -= Remaining;
+        while (Remaining > 0)
+        {
+            OutboundChunk& Front = Outbox.front();
+            std::size_t Left = Front.Buffer->size() - Front.Offset;
+            if (Remaining < Left)
+            {
+                Front.Offset += Remaining;
+                break;
+            }
+            Remaining -= Left;
+            Outbox.pop_front();
+        }
+    }
+    return Outbox.empty() && Paced.empty();
+}
+/** 역압 상태 확인 */
+bool Session::IsBackpressured() const
+{
+    return OutboxBytes >= HighWaterMark;
+}
+/** 하이 워터 마크 설정 */
+void Session::SetHighWaterMark(std::size_t Bytes)
+{
+    HighWaterMark = Bytes;
+}
+/** 송신 큐 크기 */
+std::size_t Session::GetQueuedBytes() const
+{
+    return OutboxBytes;
+}
+/** 연결 끊기 (소켓은 그대로 둠) */
+void Session::Abort()
+{
+    // shutdown wakes whoever waits on this socket; the owner closes it afterwards
+    if (SocketHandle != -1 && !bAborted)
+        shutdown(SocketHandle, SHUT_RDWR);
+
+    bAborted = true;
+    Outbox.clear();
+    Paced.clear();
+    OutboxBytes = 0;
+}
+/** 끊긴 연결인지 확인 */
+bool Session::IsAborted() const
+{
+    return bAborted;
 }
 /** 세션 종료 */
 void Session::Close()
@@ -35,4 +163,8 @@ void Session::Close()
         close(SocketHandle);
         SocketHandle = -1;
     }
+
+    Outbox.clear();
+    Paced.clear();
+    OutboxBytes = 0;
 }
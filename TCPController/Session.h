@@ -1,42 +1,134 @@
 #pragma once
 #include <string>
+#include <deque>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "ControlFrame.h"
+
+/** 세션 핸들 = (세대 << 32) | 슬롯 번호 (SessionTable 참고)
+    UDP 헤더의 session_id 로도 그대로 사용
+*/
+using SessionHandle = uint64_t;
+
+/** 어떤 세션도 가리키지 않는 핸들 */
+constexpr SessionHandle InvalidSessionHandle = 0;
 
 /** TCP 통신에서 단일 유저 연결을 표현하는 실제 세션 클래스
 */
 class Session
 {
 public:
-    /** 생성자
-        @input InSessionId 세션 고유 아이디
+    /** 생성자 (SessionTable 이 호출)
+        @input InSessionId 세션 핸들
     */
-    Session(int32 InSessionId);
+    explicit Session(SessionHandle InSessionId);
 
     /** 소멸자
         세션 종료 처리 포함
     */
     ~Session();
 
-    /** 세션 고유 아이디 반환
-        @return 세션 ID
+    /** 세션 핸들 반환
+        @return 세션 ID (SessionTable 핸들)
     */
-    int32 GetId() const;
+    SessionHandle GetId() const;
 
-    /** 클라이언트로 메시지 전송
+    /** 클라이언트로 메시지 전송 (길이 헤더를 붙인 프레임으로 전송)
+        송신 큐에 넣고 바로 보낼 수 있는 만큼 보냄 (블로킹하지 않음)
         @input Message 전송할 메시지
     */
     void Send(const std::string& Message);
 
+    /** 이미 프레임으로 만든 공유 버퍼를 송신 큐에 넣음
+        브로드캐스트는 버퍼 하나를 모든 세션이 함께 가리킴
+        @input Frame EncodeControlFrame 결과
+    */
+    void SendShared(const std::shared_ptr<const std::string>& Frame);
+
+    /** 송신 큐가 하이 워터 마크 아래로 빠질 때마다 조금씩 넣는 전송
+        FILE_MANIFEST / DIR_INDEX 조각처럼 한꺼번에 넣으면 한도를 넘는 긴 메시지열에 사용
+        대기 중인 동안 이후의 Send 도 그 뒤에 줄을 섬 (순서 유지)
+        @input Message 전송할 메시지
+    */
+    void SendPaced(const std::string& Message);
+
+    /** 송신 큐를 writev 로 보낼 수 있는 만큼 보냄 (매 틱 호출)
+        @return 큐를 모두 비웠으면 true
+    */
+    bool Flush();
+
+    /** 송신 큐가 하이 워터 마크를 넘었는지 여부
+        넘은 세션은 명령 읽기를 멈추고 버릴 수 있는 이벤트는 보내지 않음
+    */
+    bool IsBackpressured() const;
+
+    /** 송신 큐 하이 워터 마크 설정
+        @input Bytes 바이트 수
+    */
+    void SetHighWaterMark(std::size_t Bytes);
+
+    /** 송신 큐에 남은 바이트 수 */
+    std::size_t GetQueuedBytes() const;
+
+    /** 연결만 끊고 소켓은 닫지 않음
+        송신 실패 / 송신 큐 한도 초과처럼 세션 코루틴 밖에서 끊을 때 사용
+        소켓을 기다리던 세션 코루틴이 깨어나 등록 해제 후 Close 함
+    */
+    void Abort();
+
+    /** Abort 된 세션인지 여부 */
+    bool IsAborted() const;
+
     /** 세션 종료 함수
         소켓 종료, 버퍼 정리 등 수행
     */
     void Close();
 
 private:
-    /** 세션 고유 아이디 */
-    int32 SessionId;
+    /** 소켓 핸들 할당 등 내부 접근 허용 */
+    friend class TCPController;
+
+    /** 세션 핸들 */
+    SessionHandle SessionId;
 
     /** 내부 소켓 핸들 혹은 네트워크 연결 객체
         실제 구현은 TCPController.cpp 또는 네트워크 모듈에서 처리
     */
     int32 SocketHandle;
+
+    /** 수신 링 버퍼 (여러 번에 나뉘어 온 명령 프레임을 모아 둠) */
+    ControlFrameReader Inbox;
+
+    /** 송신 큐 항목 (참조 카운트 버퍼 + 이미 보낸 위치) */
+    struct OutboundChunk
+    {
+        std::shared_ptr<const std::string> Buffer;
+        std::size_t Offset;
+    };
+
+    /** 송신 큐 */
+    std::deque<OutboundChunk> Outbox;
+
+    /** 송신 큐에 남은 바이트 수 */
+    std::size_t OutboxBytes;
+
+    /** 송신 큐가 빠지길 기다리는 프레임 (SendPaced 와 그 뒤에 들어온 프레임) */
+    std::deque<std::shared_ptr<const std::string>> Paced;
+
+    /** 이 이상 쌓이면 역압(backpressure) 상태 */
+    std::size_t HighWaterMark;
+
+    /** 연결이 끊겼는지 여부 (더 보내지 않음) */
+    bool bAborted;
+
+    /** 기본 하이 워터 마크 */
+    static constexpr std::size_t DefaultHighWaterMark = 4 * 1024 * 1024;
+
+    /** 하이 워터 마크의 이 배수를 넘으면 읽지 않는 클라이언트로 보고 연결 종료 */
+    static constexpr std::size_t HardLimitFactor = 4;
+
+    /** writev 한 번에 묶는 최대 버퍼 수 */
+    static constexpr int MaxIovecs = 64;
 };
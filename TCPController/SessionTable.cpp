@@ -0,0 +1,88 @@
+#include "SessionTable.h"
+
+// ------------------------------------
+// Create / Destroy
+// ------------------------------------
+
+SessionHandle SessionTable::Create()
+{
+    /** Reuse a freed slot first, otherwise take the next slot (new block when the last one is full) */
+
+    uint32_t Index;
+    if (!FreeSlots.empty())
+    {
+        Index = FreeSlots.back();
+        FreeSlots.pop_back();
+    }
+    else
+    {
+        Index = SlotCount++;
+        if (Index / BlockSize == Blocks.size())
+            Blocks.emplace_back(new Slot[BlockSize]);
+    }
+
+    Slot& Entry = SlotAt(Index);
+    SessionHandle Handle = (static_cast<uint64_t>(Entry.Generation) << 32) | Index;
+
+    Entry.Object.emplace(Handle);
+    Entry.LivePos = static_cast<uint32_t>(Live.size());
+    Live.push_back(&*Entry.Object);
+
+    return Handle;
+}
+
+bool SessionTable::Destroy(SessionHandle Handle)
+{
+    if (Get(Handle) == nullptr)
+        return false;
+
+    uint32_t Index = SlotOf(Handle);
+    Slot& Entry = SlotAt(Index);
+
+    // Swap-remove from the dense list and fix the moved session's position
+    Session* Moved = Live.back();
+    Live[Entry.LivePos] = Moved;
+    SlotAt(SlotOf(Moved->GetId())).LivePos = Entry.LivePos;
+    Live.pop_back();
+
+    Entry.Object.reset();
+
+    // New generation: handles of the destroyed session stop resolving
+    if (++Entry.Generation == 0)
+        Entry.Generation = 1;
+
+    FreeSlots.push_back(Index);
+    return true;
+}
+
+void SessionTable::Clear()
+{
+    while (!Live.empty())
+        Destroy(Live.back()->GetId());
+}
+
+// ------------------------------------
+// Lookup
+// ------------------------------------
+
+Session* SessionTable::Get(SessionHandle Handle) const
+{
+    uint32_t Index = SlotOf(Handle);
+    if (Index >= SlotCount)
+        return nullptr;
+
+    Slot& Entry = SlotAt(Index);
+    if (!Entry.Object || Entry.Generation != static_cast<uint32_t>(Handle >> 32))
+        return nullptr;
+
+    return &*Entry.Object;
+}
+
+SessionHandle SessionTable::HandleAt(uint32_t Index) const
+{
+    if (Index >= SlotCount)
+        return InvalidSessionHandle;
+
+    const Slot& Entry = SlotAt(Index);
+    return Entry.Object ? Entry.Object->GetId() : InvalidSessionHandle;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Session.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/** 세션 객체를 블록 단위로 미리 잡아 두고 재사용하는 세션 저장소
+    - 생성/삭제 O(1) (빈 슬롯 스택), 블록은 옮기지 않으므로 Session 주소가 바뀌지 않음
+    - 살아 있는 세션은 연속 배열로 따로 유지해 브로드캐스트/정리 순회가 빠름
+    - 핸들 = (세대 << 32) | 슬롯 번호
+      슬롯을 재사용할 때 세대가 바뀌므로, 끊긴 세션의 핸들로는 새 세션에 닿지 않음
+      (소켓 fd 는 바로 재사용되므로 세션 키로 쓰면 이전 세션 상태가 새 클라이언트에게 넘어감)
+*/
+class SessionTable
+{
+public:
+    /** 블록 하나에 담는 세션 수 */
+    static constexpr uint32_t BlockSize = 1024;
+
+    SessionTable() = default;
+    SessionTable(const SessionTable&) = delete;
+    SessionTable& operator=(const SessionTable&) = delete;
+
+    /** 새 세션 생성
+        @return 새 세션의 핸들
+    */
+    SessionHandle Create();
+
+    /** 핸들로 세션 조회
+        @input Handle 세션 핸들
+        @return 살아 있는 세션, 이미 삭제된(세대가 다른) 핸들이면 nullptr
+    */
+    Session* Get(SessionHandle Handle) const;
+
+    /** 세션 삭제 (슬롯은 다음 Create 에서 재사용)
+        @input Handle 세션 핸들
+        @return 살아 있던 세션이면 true
+    */
+    bool Destroy(SessionHandle Handle);
+
+    /** 슬롯 번호에 지금 들어 있는 세션의 핸들 (비어 있으면 InvalidSessionHandle)
+        핸들 전체를 담을 수 없는 곳(타이머 userData 등)에서 슬롯 번호만 저장할 때 사용
+    */
+    SessionHandle HandleAt(uint32_t Index) const;
+
+    /** 핸들의 슬롯 번호 */
+    static uint32_t SlotOf(SessionHandle Handle) { return static_cast<uint32_t>(Handle); }
+
+    /** 살아 있는 모든 세션 순회 (순회 중에 Create / Destroy 하면 안 됨)
+        @input Func void(Session&)
+    */
+    template <typename FuncType>
+    void ForEach(FuncType&& Func) const
+    {
+        for (Session* Object : Live)
+            Func(*Object);
+    }
+
+    /** 살아 있는 세션 수 */
+    std::size_t Size() const { return Live.size(); }
+
+    /** 모든 세션 삭제 (블록은 유지) */
+    void Clear();
+
+private:
+    struct Slot
+    {
+        std::optional<Session> Object;
+
+        /** 현재(또는 다음에 만들) 세션의 세대 (0 은 쓰지 않음) */
+        uint32_t Generation = 1;
+
+        /** Live 안의 위치 */
+        uint32_t LivePos = 0;
+    };
+
+    Slot& SlotAt(uint32_t Index) const { return Blocks[Index / BlockSize][Index % BlockSize]; }
+
+    /** 세션 저장 블록 (한 번 잡은 블록은 해제하지 않음) */
+    std::vector<std::unique_ptr<Slot[]>> Blocks;
+
+    /** 지금까지 쓴 슬롯 수 (이 뒤로는 한 번도 쓰지 않은 슬롯) */
+    uint32_t SlotCount = 0;
+
+    /** 비어 있는 슬롯 번호 (스택) */
+    std::vector<uint32_t> FreeSlots;
+
+    /** 살아 있는 세션 (삭제 시 마지막 항목과 자리를 바꿔 O(1) 로 뺌) */
+    std::vector<Session*> Live;
+};
@@ -1,5 +1,6 @@
 #include "ClientUDPReceiver.h"
 #include "UdpPacketHeader.h"
+#include "Trace.h"
 
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -52,6 +53,8 @@ void ClientUDPReceiver::Run()
         if (recvBytes <= 0)
             continue;
 
+        TRACE_INSTANT("UdpRecv", recvBytes);
+
         // Forward raw packet to UDP model
         m_model.ProcessReceivedPacket(buffer, recvBytes);
 
@@ -1,19 +1,94 @@
 #include "TCPController.h"
 #include "Session.h"
+#include "Trace.h"
 
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+    /** Split result and the budget it holds, freed together (SharedPackets aliases Packets) */
+    struct AccountedPackets
+    {
+        std::vector<Packet> Packets;
+        MemoryReservation Reservation;
+    };
+
+    /** Heap bytes held by a split result */
+    uint64_t PacketMemoryBytes(const std::vector<Packet>& Packets)
+    {
+        uint64_t Bytes = Packets.capacity() * sizeof(Packet);
+        for (const Packet& P : Packets)
+            Bytes += P.data.capacity();
+        return Bytes;
+    }
+
+    /** Memory a bulk command will need once its file (or directory) is split */
+    uint64_t EstimateTransferBytes(const std::string& Path, std::size_t ChunkSize)
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code Ec;
+        uint64_t FileBytes = 0;
+        if (fs::is_directory(Path, Ec))
+        {
+            for (fs::recursive_directory_iterator It(Path, Ec), End; !Ec && It != End; It.increment(Ec))
+                if (It->is_regular_file(Ec))
+                    FileBytes += It->file_size(Ec);
+        }
+        else
+        {
+            FileBytes = fs::file_size(Path, Ec);
+            if (Ec)
+                FileBytes = 0;
+        }
+
+        uint64_t Chunks = FileBytes / ChunkSize + 1;
+        return FileBytes + Chunks * sizeof(Packet);
+    }
+}
 
 // ------------------------------------
 // 생성자 / 소멸자
 // ------------------------------------
 
-TCPController::TCPController()
+TCPController::TCPController(uint16_t InListenPort)
     : ListenSocket(-1)
+    , ListenPort(InListenPort)
+    , UdpSocket(-1)
+    , TimerEpoch(SendScheduler::Clock::now())
 {
     /** Internal state initialization */
+
+    if (const char* Token = std::getenv("UDPTCP_ADMIN_TOKEN"))
+        AdminToken = Token;
+}
+
+void TCPController::SetAdminToken(const std::string& Token)
+{
+    AdminToken = Token;
+    AdminSessions.clear();
+}
+
+void TCPController::SetTraceDirectory(const std::string& Directory)
+{
+    TraceDirectory = Directory;
+}
+
+bool TCPController::RequireAdmin(Session* SessionObj, std::string_view Command)
+{
+    if (AdminSessions.contains(SessionObj->GetId()))
+        return true;
+
+    SessionObj->Send("ADMIN_REQUIRED " + std::string(Command));
+    return false;
 }
 
 TCPController::~TCPController()
@@ -36,7 +111,7 @@ bool TCPController::Init()
     sockaddr_in Addr{};
     Addr.sin_family = AF_INET;
     Addr.sin_addr.s_addr = INADDR_ANY;
-    Addr.sin_port = htons(7777);
+    Addr.sin_port = htons(ListenPort);
 
     if (bind(ListenSocket, (sockaddr*)&Addr, sizeof(Addr)) < 0)
         return false;
@@ -50,18 +125,27 @@ bool TCPController::Init()
     if (UdpSocket < 0)
         return false;
 
+    /** Event loop: accept and transfer coroutines (sessions are spawned per connection) */
+
+    fcntl(ListenSocket, F_SETFL, fcntl(ListenSocket, F_GETFL) | O_NONBLOCK);
+
+    if (!Io.Init() || !Io.Register(ListenSocket))
+        return false;
+
+    Io.Spawn(AcceptLoop());
+    Io.Spawn(TransferLoop());
+
     return true;
 }
 
 
 void TCPController::Shutdown()
 {
-    for (auto& Pair : Sessions)
-    {
-        Pair.second->Close();
-        delete Pair.second;
-    }
-    Sessions.clear();
+    // Coroutine frames first: they hold session handles and sockets
+    Io.Shutdown();
+
+    Sessions.ForEach([](Session& SessionObj) { SessionObj.Close(); });
+    Sessions.Clear();
 
     if (ListenSocket != -1)
     {
@@ -82,156 +166,1498 @@ void TCPController::Shutdown()
 
 ISession* TCPController::CreateSession(int32 ConnectionId)
 {
-    /** Create new session */
+    /** Create new session in a slab slot (generation-tagged handle, no per-session new) */
 
-    ISession* NewSession = new Session(ConnectionId);
-    Sessions.emplace(ConnectionId, NewSession);
+    Session* NewSession = Sessions.Get(Sessions.Create());
+    NewSession->SocketHandle = ConnectionId;
     return NewSession;
 }
 
-void TCPController::SendToSession(int32 SessionId, const std::string& Message)
+void TCPController::SendToSession(SessionHandle SessionId, const std::string& Message)
 {
-    /** Send message to specific session */
+    /** Send message to specific session (stale handles resolve to nothing) */
 
-    if (Sessions.contains(SessionId))
-        Sessions[SessionId]->Send(Message);
+    if (Session* SessionObj = Sessions.Get(SessionId))
+        SessionObj->Send(Message);
 }
 
 void TCPController::Broadcast(const std::string& Message)
 {
-    /** Broadcast message to all sessions */
+    /** Broadcast message to all sessions (one shared frame, no per-session copy) */
+
+    auto Frame = std::make_shared<const std::string>(EncodeControlFrame(Message));
 
-    for (auto& Pair : Sessions)
-        Pair.second->Send(Message);
+    Sessions.ForEach([&Frame](Session& SessionObj)
+    {
+        // A slow client misses broadcast events instead of stalling or bloating everyone else
+        if (!SessionObj.IsBackpressured())
+            SessionObj.SendShared(Frame);
+    });
 }
 
 // ------------------------------------
 // Network Accept / Update
 // ------------------------------------
 
-void TCPController::AcceptClient()
+bool TCPController::AcceptClient()
 {
     /** Accept incoming TCP connection */
 
     int ClientSocket = accept(ListenSocket, nullptr, nullptr);
     if (ClientSocket < 0)
-        return;
+        return false;
 
-    int32 SessionId = ClientSocket;
+    // Create session object (takes ownership of the socket)
+    Session* NewSession = static_cast<Session*>(CreateSession(ClientSocket));
 
-    // Create session object
-    ISession* NewSession = CreateSession(SessionId);
+    // The handle doubles as the UDP session_id of this client's transfers
+    NewSession->Send("SESSION " + std::to_string(NewSession->GetId()));
 
-    // Assign socket handle to session (internal access)
-    static_cast<Session*>(NewSession)->SocketHandle = ClientSocket;
+    Io.Spawn(SessionLoop(NewSession->GetId()));
+    return true;
 }
 
 void TCPController::Update()
 {
-    /** Iterate sessions and process incoming commands */
+    /** One non-blocking reactor step for callers that drive their own loop */
+
+    Io.RunOnce(0);
+}
+
+void TCPController::Run()
+{
+    Io.Run();
+}
+
+// ------------------------------------
+// Coroutines
+// ------------------------------------
+
+Task TCPController::AcceptLoop()
+{
+    /** Edge-triggered listen socket: accept until EAGAIN, then wait for the next edge */
+
+    while (true)
+    {
+        while (AcceptClient())
+        {
+        }
+
+        co_await Io.WaitIo(ListenSocket);
+    }
+}
+
+Task TCPController::SessionLoop(SessionHandle Handle)
+{
+    /** One coroutine per control connection: flush, read commands, sleep until the socket changes */
 
-    char Buffer[1024];
+    int Socket = Sessions.Get(Handle)->SocketHandle;
+    Io.Register(Socket);
 
-    for (auto& Pair : Sessions)
+    while (true)
     {
-        Session* SessionObj = static_cast<Session*>(Pair.second);
-        int Socket = SessionObj->SocketHandle;
+        // Re-resolve after every suspension; only this coroutine destroys the session
+        Session* SessionObj = Sessions.Get(Handle);
+        if (SessionObj == nullptr || SessionObj->IsAborted())
+            break;
 
-        memset(Buffer, 0, sizeof(Buffer));
+        // Finish writes left over from earlier wakeups
+        SessionObj->Flush();
 
-        int RecvBytes = recv(Socket, Buffer, sizeof(Buffer), MSG_DONTWAIT);
-        if (RecvBytes <= 0)
-            continue;
+        /** Backpressure: stop reading commands from a client that is not reading its replies */
+        if (!SessionObj->IsBackpressured())
+        {
+            if (!ReadCommands(SessionObj))
+                break;
+
+            SendWork.Notify();
+        }
+
+        co_await Io.WaitIo(Socket);
+    }
+
+    Io.Unregister(Socket);
+    DestroySession(Handle);
+}
+
+Task TCPController::TransferLoop()
+{
+    /** Drives every transfer through the DRR scheduler; transfers are flows, not coroutines */
+
+    while (true)
+    {
+        AdmitPendingTransfers();
+        FlushFanoutRepairs();
+        ProcessRetransmitTimers();
+        bool bMore = PumpSendQueue();
+        FlushNotifications();
+
+        if (bMore)
+            co_await Io.Yield();  // hit the per-round cap: let sockets in, then continue
+        else if (Scheduler.HasRunnable())
+            co_await Io.Sleep(1);  // paced by the rate limit
+        else
+            co_await SendWork.WaitFor(NextTimedWorkMs());  // until a command or event, or the next deadline
+    }
+}
+
+bool TCPController::ReadCommands(Session* SessionObj)
+{
+    /** Read the socket into the ring buffer and run all complete commands */
+
+    ControlFrameReader& Inbox = SessionObj->Inbox;
+
+    while (true)
+    {
+        auto Result = Inbox.ReadFrom(SessionObj->SocketHandle);
+
+        // Process every pipelined command in the buffer
+        std::string_view Command;
+        while (Inbox.NextFrame(Command))
+            ProcessCommand(SessionObj, Command);
 
-        std::string Command(Buffer, RecvBytes);
+        /** Oversized frame or peer gone */
+        if (Inbox.HasError() || Result == ControlFrameReader::EReadResult::Closed)
+            return false;
 
-        // Process command per session
-        ProcessCommand(SessionObj, Command);
+        // A full buffer may hide more data in the socket
+        if (Result != ControlFrameReader::EReadResult::Full)
+            return true;
     }
 }
 
+uint64_t TCPController::NextTimedWorkMs() const
+{
+    /** Earliest deadline the transfer loop must wake for; commands and events wake it through SendWork */
+
+    auto Now = SendScheduler::Clock::now();
+    auto MsUntil = [Now](SendScheduler::Clock::time_point Deadline) -> uint64_t {
+        if (Deadline <= Now)
+            return 0;
+        return std::chrono::ceil<std::chrono::milliseconds>(Deadline - Now).count();
+    };
+
+    uint64_t DelayMs = NoTimedWork;
+
+    if (RetransmitTimers.Size() > 0)
+    {
+        uint64_t NowTick = NowUs() / 1000;
+        uint64_t NextTick = RetransmitTimers.NextExpiryTick();
+        DelayMs = NextTick > NowTick ? NextTick - NowTick : 0;
+    }
+
+    if (!PendingEvents.empty())
+        DelayMs = std::min(DelayMs, MsUntil(NextNotifyTime));
+
+    if (!PendingTransfers.empty())
+        DelayMs = std::min(DelayMs, AdmissionPollMs);
+
+    for (const auto& Pair : FanoutChannels)
+        if (Pair.second.RepairPending)
+            DelayMs = std::min(DelayMs, MsUntil(Pair.second.RepairDeadline));
+
+    return DelayMs;
+}
+
 // ------------------------------------
 // Command Routing
 // ------------------------------------
 
-void TCPController::ProcessCommand(Session* SessionObj, const std::string& Command)
+void TCPController::ProcessCommand(Session* SessionObj, std::string_view Command)
+{
+    /** Bulk transfers reserve memory before loading anything; over budget they wait their turn */
+
+    if (!AdmitTransfer(SessionObj, Command))
+        return;
+
+    DispatchCommand(SessionObj, Command);
+
+    // Whatever the command did not attach to its packets goes back to the budget
+    Admission.Release();
+}
+
+void TCPController::DispatchCommand(Session* SessionObj, std::string_view Command)
 {
     /** Route behavior based on command */
 
     if (Command.starts_with("FILE_SEND "))
     {
-        // FILE_SEND <filename> <client_ip> <udp_port>
+        // FILE_SEND <filename> <client_ip> <udp_port> [FEC <k> <m>] [COMPRESS]
+        //           [RESUME <file_size> <mtime_ns> <missing_ranges>] [WINDOW <packets>]
 
-        std::istringstream iss(Command);
+        CommandReader args(Command);
         std::string cmd, filename, ip;
         int port;
 
-        iss >> cmd >> filename >> ip >> port;
+        args >> cmd >> filename >> ip >> port;
+
+        /** Options
+            FEC <k> <m> : k data chunks + m parity chunks per group
+            COMPRESS    : per-chunk LZ compression when the file is compressible
+            RESUME      : client already holds part of this file (identity from FILE_INFO),
+                          only the listed ranges are sent if the file is unchanged
+            WINDOW      : streaming receiver with a reorder window of this many packets;
+                          data beyond the window waits for FILE_WINDOW
+        */
+        std::string option;
+        uint32_t fecK = 0, fecM = 0;
+        bool compress = false;
+        bool resume = false;
+        uint64_t resumeSize = 0;
+        int64_t resumeMtime = 0;
+        std::string resumeRanges;
+        uint64_t windowPackets = 0;
+        while (args >> option)
+        {
+            if (option == "FEC")
+                args >> fecK >> fecM;
+            else if (option == "COMPRESS")
+                compress = true;
+            else if (option == "RESUME")
+            {
+                resume = true;
+                args >> resumeSize >> resumeMtime >> resumeRanges;
+            }
+            else if (option == "WINDOW")
+                args >> windowPackets;
+        }
+
+        /** A malformed range list rejects the request instead of falling back to a full send */
+        std::vector<PacketRange> resumeList;
+        if (resume && !ParsePacketRanges(resumeRanges, resumeList))
+            return;
 
-        /** Setup client UDP address */
+        /** Setup client UDP address (per session: resends and FILE_HAVE go back to this client) */
+        sockaddr_in& ClientUdpAddr = ClientUdpAddrs[SessionObj->GetId()];
         ClientUdpAddr.sin_family = AF_INET;
         ClientUdpAddr.sin_port = htons(port);
         ClientUdpAddr.sin_addr.s_addr = inet_addr(ip.c_str());
 
+        /** File identity (size + mtime) for resumable transfers */
+        struct stat FileStat{};
+        if (stat(filename.c_str(), &FileStat) != 0)
+            return;
+
+        uint64_t fileSize = static_cast<uint64_t>(FileStat.st_size);
+        int64_t fileMtime = static_cast<int64_t>(FileStat.st_mtim.tv_sec) * 1000000000LL + FileStat.st_mtim.tv_nsec;
+
         /** Split file */
         FileSplitterAndMerger fsm;
-        auto packets = fsm.SplitFile(filename, 1024);
+        auto packets = fsm.SplitFile(filename, FileChunkSize);
 
         uint64_t sessionId = SessionObj->GetId();
         uint64_t totalPackets = packets.size();
 
-        /** Cache packets for retransmission */
-        SentPacketCache[sessionId] = packets;
+        /** Tell the client what it is receiving before any data arrives */
+        SessionObj->Send("FILE_INFO " + std::to_string(totalPackets) + " " + std::to_string(fileSize) + " "
+                         + std::to_string(fileMtime) + " " + std::to_string(FileChunkSize));
+
+        /** Packets to send: everything, or only the missing ranges of an unchanged file */
+        std::vector<bool> wanted(totalPackets, true);
+        if (resume && resumeSize == fileSize && resumeMtime == fileMtime)
+        {
+            wanted.assign(totalPackets, false);
+            for (const auto& r : resumeList)
+                for (uint64_t i = r.begin; i < r.end && i < totalPackets; ++i)
+                    wanted[i] = true;
+        }
+
+        /** Digest and parity cover the original bytes, so build them before compressing */
+        uint32_t fileDigest = FileSplitterAndMerger::ComputeFileDigest(packets);
+
+        SharedPackets parity;
+        if (fecM > 0)
+            parity = AccountPackets(FileSplitterAndMerger::BuildParityPackets(packets, fecK, fecM));
+
+        if (compress)
+            FileSplitterAndMerger::CompressPackets(packets);
+
+        /** Cache packets for retransmission (wire form, so resends stay compressed) */
+        auto shared = AccountPackets(std::move(packets));
+        SentPacketCache[sessionId] = shared;
+
+        /** Streaming receiver: never run ahead of what its reorder window can hold */
+        if (windowPackets > 0)
+            Scheduler.SetFlowWindow(sessionId, windowPackets);
+        else
+            Scheduler.ClearFlowWindow(sessionId);
+
+        SendPacketStream(sessionId, sessionId, shared, wanted, parity, fecK, fecM, {ClientUdpAddr});
+
+        /** Notify client with whole-file digest for end-to-end verification (after the last datagram) */
+        std::string doneMessage = "FILE_SEND_DONE " + std::to_string(fileDigest);
+        BeginReliableTransfer(sessionId, shared, wanted, doneMessage);
+        EnqueueMessage(sessionId, SessionObj->GetId(), doneMessage);
+    }
+    else if (Command.starts_with("FILE_SEND_CDC "))
+    {
+        // FILE_SEND_CDC <filename> <client_ip> <udp_port>
+        // Content-defined chunks; the client answers FILE_HAVE after the LAST manifest part, before any data is sent
+
+        CommandReader args(Command);
+        std::string cmd, filename, ip;
+        int port;
+
+        args >> cmd >> filename >> ip >> port;
+
+        /** Setup client UDP address (per session: resends and FILE_HAVE go back to this client) */
+        sockaddr_in& ClientUdpAddr = ClientUdpAddrs[SessionObj->GetId()];
+        ClientUdpAddr.sin_family = AF_INET;
+        ClientUdpAddr.sin_port = htons(port);
+        ClientUdpAddr.sin_addr.s_addr = inet_addr(ip.c_str());
+
+        FileSplitterAndMerger fsm;
+        auto packets = fsm.SplitFileContentDefined(filename);
+
+        uint64_t sessionId = SessionObj->GetId();
+
+        /** Keep chunks until the client tells us which ones it already holds */
+        ManifestDigestCache[sessionId] = FileSplitterAndMerger::ComputeFileDigest(packets);
+
+        SendListInParts(SessionObj, "FILE_MANIFEST " + std::to_string(packets.size()),
+                        FileSplitterAndMerger::EncodeManifest(FileSplitterAndMerger::BuildManifest(packets)), ',');
+
+        SentPacketCache[sessionId] = AccountPackets(std::move(packets));
+    }
+    else if (Command.starts_with("FILE_HAVE"))
+    {
+        // FILE_HAVE [<ranges>]
+        // Chunk indices of the manifest the client already holds locally
+
+        CommandReader args(Command);
+        std::string cmd, haveRanges;
+
+        args >> cmd >> haveRanges;
+
+        uint64_t sessionId = SessionObj->GetId();
+
+        if (!SentPacketCache.contains(sessionId) || !ManifestDigestCache.contains(sessionId) ||
+            !ClientUdpAddrs.contains(sessionId))
+            return;
+
+        const SharedPackets& packets = SentPacketCache[sessionId];
+        uint64_t totalPackets = packets->size();
+
+        std::vector<bool> have(totalPackets, false);
+        std::vector<PacketRange> ranges;
+        if (!ParsePacketRanges(haveRanges, ranges))
+            return;
+        for (const auto& r : ranges)
+            for (uint64_t i = r.begin; i < r.end && i < totalPackets; ++i)
+                have[i] = true;
+
+        /** Only chunks the client does not have travel over UDP */
+        have.flip();
+        SendPacketStream(sessionId, sessionId, packets, have, nullptr, 0, 0, {ClientUdpAddrs[sessionId]});
+
+        std::string doneMessage = "FILE_SEND_DONE " + std::to_string(ManifestDigestCache[sessionId]);
+        BeginReliableTransfer(sessionId, packets, have, doneMessage);
+        EnqueueMessage(sessionId, SessionObj->GetId(), doneMessage);
+        ManifestDigestCache.erase(sessionId);
+    }
+    else if (Command.starts_with("DIR_SEND "))
+    {
+        // DIR_SEND <directory> <client_ip> <udp_port> [COMPRESS]
+        // Whole directory as one packet stream: small files packed back to back, large files after them
+
+        CommandReader args(Command);
+        std::string cmd, dirname, ip, option;
+        int port;
+        bool compress = false;
+
+        args >> cmd >> dirname >> ip >> port;
+        while (args >> option)
+        {
+            if (option == "COMPRESS")
+                compress = true;
+        }
+
+        /** Setup client UDP address (per session: resends and FILE_HAVE go back to this client) */
+        sockaddr_in& ClientUdpAddr = ClientUdpAddrs[SessionObj->GetId()];
+        ClientUdpAddr.sin_family = AF_INET;
+        ClientUdpAddr.sin_port = htons(port);
+        ClientUdpAddr.sin_addr.s_addr = inet_addr(ip.c_str());
+
+        FileSplitterAndMerger fsm;
+        std::vector<DirectoryEntry> index;
+        auto packets = fsm.SplitDirectory(dirname, FileChunkSize, index);
+
+        uint64_t sessionId = SessionObj->GetId();
+
+        /** Index first, so the client can place every file once the stream completes */
+        SendListInParts(SessionObj, "DIR_INDEX " + std::to_string(packets.size()),
+                        FileSplitterAndMerger::EncodeDirectoryIndex(index), ';');
+
+        uint32_t streamDigest = FileSplitterAndMerger::ComputeFileDigest(packets);
+
+        if (compress)
+            FileSplitterAndMerger::CompressPackets(packets);
+
+        /** One cache entry and one completion for the whole directory, not one per file */
+        auto shared = AccountPackets(std::move(packets));
+        SentPacketCache[sessionId] = shared;
+
+        std::vector<bool> wanted(shared->size(), true);
+        SendPacketStream(sessionId, sessionId, shared, wanted, nullptr, 0, 0, {ClientUdpAddr});
+
+        std::string doneMessage = "FILE_SEND_DONE " + std::to_string(streamDigest);
+        BeginReliableTransfer(sessionId, shared, wanted, doneMessage);
+        EnqueueMessage(sessionId, SessionObj->GetId(), doneMessage);
+    }
+    else if (Command.starts_with("FILE_RANGE "))
+    {
+        // FILE_RANGE <filename> <client_ip> <udp_port> <transfer_id> [<ranges>]
+        // Client-driven range request; the client may pull disjoint ranges of one file from several servers
+
+        CommandReader args(Command);
+        std::string cmd, filename, ip, requested;
+        int port;
+        uint64_t transferId;
+
+        if (!(args >> cmd >> filename >> ip >> port >> transferId))
+            return;
+        args >> requested;
+
+        std::vector<PacketRange> ranges;
+        if (!ParsePacketRanges(requested, ranges))
+            return;
+
+        struct stat FileStat{};
+        if (stat(filename.c_str(), &FileStat) != 0)
+            return;
+
+        uint64_t fileSize = static_cast<uint64_t>(FileStat.st_size);
+        int64_t fileMtime = static_cast<int64_t>(FileStat.st_mtim.tv_sec) * 1000000000LL + FileStat.st_mtim.tv_nsec;
+
+        /** Split once per file version, not once per range request */
+        RangeSource& Source = RangeSourceCache[filename];
+        if (!Source.Packets || Source.Size != fileSize || Source.Mtime != fileMtime)
+        {
+            FileSplitterAndMerger fsm;
+            auto packets = fsm.SplitFile(filename, FileChunkSize);
+            Source.Digest = FileSplitterAndMerger::ComputeFileDigest(packets);
+            Source.Packets = AccountPackets(std::move(packets), MEM_SEND_CACHE);
+            Source.Size = fileSize;
+            Source.Mtime = fileMtime;
+        }
+
+        uint64_t totalPackets = Source.Packets->size();
+
+        /** Identity lets the client check that every server holds the same file */
+        SessionObj->Send("FILE_INFO " + std::to_string(totalPackets) + " " + std::to_string(fileSize) + " "
+                         + std::to_string(fileMtime) + " " + std::to_string(FileChunkSize));
+
+        std::vector<bool> wanted(totalPackets, false);
+        for (const auto& r : ranges)
+            for (uint64_t i = r.begin; i < r.end && i < totalPackets; ++i)
+                wanted[i] = true;
+
+        sockaddr_in Addr{};
+        Addr.sin_family = AF_INET;
+        Addr.sin_port = htons(port);
+        Addr.sin_addr.s_addr = inet_addr(ip.c_str());
+
+        /** Datagrams carry the client's transfer id, so all servers feed one receive session.
+            The DRR flow is the requesting session: a client-chosen id must not share a flow
+            (weight, window, retransmit state) with another session */
+        SessionHandle FlowId = SessionObj->GetId();
+        SendPacketStream(FlowId, transferId, Source.Packets, wanted, nullptr, 0, 0, {Addr});
+
+        EnqueueMessage(FlowId, FlowId, "FILE_RANGE_DONE " + std::to_string(transferId) + " "
+                       + FormatPacketRanges(ranges) + " " + std::to_string(Source.Digest));
+    }
+    else if (Command.starts_with("FILE_RANGE_CANCEL "))
+    {
+        // FILE_RANGE_CANCEL <transfer_id> <ranges>
+        // Drop still-queued packets of earlier FILE_RANGE requests that the client moved to another server
+
+        CommandReader args(Command);
+        std::string cmd, requested;
+        uint64_t transferId;
+
+        if (!(args >> cmd >> transferId >> requested))
+            return;
+
+        std::vector<PacketRange> ranges;
+        if (!ParsePacketRanges(requested, ranges))
+            return;
+
+        Scheduler.Cancel(SessionObj->GetId(), transferId, ranges);
+    }
+    else if (Command.starts_with("FANOUT_JOIN "))
+    {
+        // FANOUT_JOIN <channel> <client_ip> <udp_port>
+        // Register as a receiver of a fan-out channel (datagrams carry session_id = channel); the first joiner owns it
+
+        CommandReader args(Command);
+        std::string cmd, ip;
+        uint64_t channelId;
+        int port;
+
+        if (!(args >> cmd >> channelId >> ip >> port))
+            return;
+
+        sockaddr_in Addr{};
+        Addr.sin_family = AF_INET;
+        Addr.sin_port = htons(port);
+        Addr.sin_addr.s_addr = inet_addr(ip.c_str());
+
+        auto [It, Created] = FanoutChannels.try_emplace(channelId);
+        FanoutChannel& Channel = It->second;
+        if (Created)
+        {
+            Channel.Owner = SessionObj->GetId();
+            Channel.FlowId = NextFanoutFlowId++;
+        }
+
+        Channel.Receivers[SessionObj->GetId()] = Addr;
+        Channel.Completed.erase(SessionObj->GetId());
+    }
+    else if (Command.starts_with("FANOUT_SEND "))
+    {
+        // FANOUT_SEND <channel> <filename> [MCAST <group_ip> <port>] [COMPRESS]
+        // Chunk the file once and deliver every datagram to all joined receivers (owner or joined member only)
+
+        CommandReader args(Command);
+        std::string cmd, filename, option;
+        uint64_t channelId;
+        bool compress = false;
+
+        args >> cmd >> channelId >> filename;
+
+        auto It = FanoutChannels.find(channelId);
+        if (It == FanoutChannels.end() || It->second.Receivers.empty())
+            return;
+        FanoutChannel& Channel = It->second;
+
+        SessionHandle Sender = SessionObj->GetId();
+        if (Channel.Owner != Sender && !Channel.Receivers.contains(Sender))
+            return;
+
+        Channel.Multicast = false;
+        while (args >> option)
+        {
+            if (option == "MCAST")
+            {
+                std::string groupIp;
+                int groupPort;
+                args >> groupIp >> groupPort;
+
+                Channel.Multicast = true;
+                Channel.GroupAddr = {};
+                Channel.GroupAddr.sin_family = AF_INET;
+                Channel.GroupAddr.sin_port = htons(groupPort);
+                Channel.GroupAddr.sin_addr.s_addr = inet_addr(groupIp.c_str());
+            }
+            else if (option == "COMPRESS")
+                compress = true;
+        }
+
+        if (Channel.Multicast)
+        {
+            /** Stay on the local segment, and loop back so same-host receivers work */
+            unsigned char Ttl = 1, Loop = 1;
+            setsockopt(UdpSocket, IPPROTO_IP, IP_MULTICAST_TTL, &Ttl, sizeof(Ttl));
+            setsockopt(UdpSocket, IPPROTO_IP, IP_MULTICAST_LOOP, &Loop, sizeof(Loop));
+        }
+
+        struct stat FileStat{};
+        if (stat(filename.c_str(), &FileStat) != 0)
+            return;
 
-        for (uint64_t i = 0; i < packets.size(); ++i)
+        uint64_t fileSize = static_cast<uint64_t>(FileStat.st_size);
+        int64_t fileMtime = static_cast<int64_t>(FileStat.st_mtim.tv_sec) * 1000000000LL + FileStat.st_mtim.tv_nsec;
+
+        /** Split, digest and compress once for all receivers */
+        FileSplitterAndMerger fsm;
+        auto packets = fsm.SplitFile(filename, FileChunkSize);
+        Channel.Digest = FileSplitterAndMerger::ComputeFileDigest(packets);
+        if (compress)
+            FileSplitterAndMerger::CompressPackets(packets);
+        Channel.Packets = AccountPackets(std::move(packets));
+
+        Channel.RepairWanted.assign(Channel.Packets->size(), false);
+        Channel.RepairPending = false;
+        Channel.Reported.clear();
+        Channel.Completed.clear();
+
+        std::string Info = "FILE_INFO " + std::to_string(Channel.Packets->size()) + " " + std::to_string(fileSize) + " "
+                           + std::to_string(fileMtime) + " " + std::to_string(FileChunkSize);
+        for (const auto& Pair : Channel.Receivers)
+            SendToSession(Pair.first, Info);
+
+        SendPacketStream(Channel.FlowId, channelId, Channel.Packets, std::vector<bool>(Channel.Packets->size(), true), nullptr, 0,
+                         0, FanoutDestinations(Channel));
+
+        for (const auto& Pair : Channel.Receivers)
+            EnqueueMessage(Channel.FlowId, Pair.first, "FILE_SEND_DONE " + std::to_string(Channel.Digest));
+    }
+    else if (Command.starts_with("FANOUT_NACK "))
+    {
+        // FANOUT_NACK <channel> [<missing_ranges>]
+        // Missing ranges of one receiver (empty = complete); merged into the next shared repair round
+
+        CommandReader args(Command);
+        std::string cmd, missingRanges;
+        uint64_t channelId;
+
+        args >> cmd >> channelId >> missingRanges;
+
+        auto It = FanoutChannels.find(channelId);
+        if (It == FanoutChannels.end() || !It->second.Receivers.contains(SessionObj->GetId()))
+            return;
+        FanoutChannel& Channel = It->second;
+
+        std::vector<PacketRange> ranges;
+        if (!ParsePacketRanges(missingRanges, ranges))
+            return;
+
+        if (ranges.empty())
+            Channel.Completed.insert(SessionObj->GetId());
+        else
+            Channel.Completed.erase(SessionObj->GetId());
+
+        for (const auto& r : ranges)
         {
-            SendUdpPacket(sessionId, i, packets[i], totalPackets);
-            usleep(1000);
+            for (uint64_t i = r.begin; i < r.end && i < Channel.RepairWanted.size(); ++i)
+            {
+                Channel.RepairWanted[i] = true;
+                Channel.RepairPending = true;
+            }
         }
 
-        /** Notify client */
-        SessionObj->Send("FILE_SEND_DONE");
+        /** The first report of a round starts the hold-off timer */
+        if (Channel.Reported.empty())
+            Channel.RepairDeadline = std::chrono::steady_clock::now() + FanoutRepairHoldoff;
+        Channel.Reported.insert(SessionObj->GetId());
     }
     else if (Command.starts_with("FILE_RESEND "))
     {
-        // FILE_RESEND <packet_index>
+        // FILE_RESEND <ranges>
+        // Bulk NACK: "a-b,c,..." (a single index is also a valid range list)
 
-        std::istringstream iss(Command);
-        std::string cmd;
-        uint64_t packetIndex;
+        CommandReader args(Command);
+        std::string_view cmd, missingRanges;
+
+        args >> cmd >> missingRanges;
 
-        iss >> cmd >> packetIndex;
+        TRACE_SCOPE("FILE_RESEND", missingRanges.size());
 
         uint64_t sessionId = SessionObj->GetId();
 
-        if (!SentPacketCache.contains(sessionId))
+        if (!SentPacketCache.contains(sessionId) || !ClientUdpAddrs.contains(sessionId))
             return;
 
-        auto& packets = SentPacketCache[sessionId];
+        const SharedPackets& packets = SentPacketCache[sessionId];
 
-        if (packetIndex >= packets.size())
+        std::vector<PacketRange> ranges;
+        if (!ParsePacketRanges(missingRanges, ranges))
             return;
 
-        /** Resend missing packet */
-        SendUdpPacket(
-            sessionId,
-            packetIndex,
-            packets[packetIndex],
-            packets.size()
-        );
+        /** Resend missing packets ahead of any queued new data */
+        SendItem Item;
+        Item.FlowId = sessionId;
+        Item.SessionId = sessionId;
+        Item.Packets = packets;
+        Item.TotalPackets = packets->size();
+        Item.Destinations = std::make_shared<const std::vector<sockaddr_in>>(1, ClientUdpAddrs[sessionId]);
+        for (const auto& r : ranges)
+        {
+            for (uint64_t i = r.begin; i < r.end && i < packets->size(); ++i)
+            {
+                Item.Index = i;
+                Item.Bytes = UDP_HEADER_BYTES + (*packets)[i].length;
+                Scheduler.Enqueue(ESendClass::Retransmit, Item);
+            }
+        }
     }
-}
+    else if (Command.starts_with("FILE_ACK "))
+    {
+        // FILE_ACK <ranges>
+        // Packets the client has received (duplicates included); stops their retransmission timers
 
+        CommandReader args(Command);
+        std::string cmd, ackRanges;
 
+        args >> cmd >> ackRanges;
 
-// ------------------------------------
-// Observer Event Receiver
-// ------------------------------------
+        auto It = ReliableTransfers.find(SessionObj->GetId());
+        if (It == ReliableTransfers.end())
+            return;
+        ReliableTransfer& Transfer = It->second;
 
-void TCPController::OnNotifyEvent(const std::string& EventName, const std::string& Payload)
-{
-    /** Handle external event notification */
+        uint64_t Now = NowUs();
+        std::vector<PacketRange> ranges;
+        if (!ParsePacketRanges(ackRanges, ranges))
+            return;
+        for (const auto& r : ranges)
+        {
+            for (uint64_t i = r.begin; i < r.end && i < Transfer.Acked.size(); ++i)
+            {
+                if (Transfer.Acked[i])
+                    continue;
+                Transfer.Acked[i] = true;
+
+                RetransmitTimers.Cancel(Transfer.Timers[i]);
+                Transfer.Timers[i] = TimerWheel::INVALID_TIMER;
+
+                /** Karn: only packets sent exactly once give an RTT sample */
+                if (Transfer.SentAtUs[i] != 0 && Now > Transfer.SentAtUs[i])
+                    Transfer.Rtt.AddSample(Now - Transfer.SentAtUs[i]);
+            }
+        }
+    }
+    else if (Command.starts_with("FILE_COMPLETE"))
+    {
+        // FILE_COMPLETE
+        // Client verified the digest; nothing more to retransmit, so the packets can go
+
+        EndReliableTransfer(SessionObj->GetId());
+        SentPacketCache.erase(SessionObj->GetId());
+        Scheduler.ClearFlowWindow(SessionObj->GetId());
+    }
+    else if (Command.starts_with("FILE_WINDOW "))
+    {
+        // FILE_WINDOW <limit>
+        // Streaming receiver flushed its in-order prefix; packets below <limit> fit its window now
+
+        CommandReader args(Command);
+        std::string cmd;
+        uint64_t limit = 0;
+
+        args >> cmd >> limit;
+        if (args)
+            Scheduler.SetFlowWindow(SessionObj->GetId(), limit);
+    }
+    else if (Command.starts_with("SEND_WEIGHT "))
+    {
+        // SEND_WEIGHT <weight>
+        // Share of egress this session's transfers get relative to others (default 1)
+
+        CommandReader args(Command);
+        std::string cmd;
+        uint32_t weight = 1;
+
+        args >> cmd >> weight;
+        Scheduler.SetWeight(SessionObj->GetId(), weight);
+    }
+    else if (Command.starts_with("ADMIN "))
+    {
+        // ADMIN <token>
+        // Authenticate this session for process-wide settings (SEND_RATE, MEM_LIMIT, TRACE_DUMP, NOTIFY_INTERVAL)
+
+        CommandReader args(Command);
+        std::string cmd, token;
+
+        bool Granted = (args >> cmd >> token) && !AdminToken.empty() && token == AdminToken;
+        if (Granted)
+            AdminSessions.insert(SessionObj->GetId());
+
+        SessionObj->Send(Granted ? "ADMIN OK" : "ADMIN DENIED");
+    }
+    else if (Command.starts_with("SEND_RATE "))
+    {
+        // SEND_RATE <bytes_per_second>
+        // Global egress cap over all transfers (0 = unlimited, otherwise at least MinSendRate); admin only
+
+        if (!RequireAdmin(SessionObj, "SEND_RATE"))
+            return;
+
+        CommandReader args(Command);
+        std::string cmd;
+        uint64_t bytesPerSecond = 0;
+
+        if (!(args >> cmd >> bytesPerSecond))
+            return;
+
+        if (bytesPerSecond != 0)
+            bytesPerSecond = std::max(bytesPerSecond, MinSendRate);
+        Scheduler.SetRateLimit(bytesPerSecond);
+    }
+    else if (Command.starts_with("SEND_STATS"))
+    {
+        // SEND_STATS
+        // Per-class queue depth and queueing latency
+
+        std::ostringstream oss;
+        oss << "SEND_STATS";
+        const char* Names[] = {"retransmit", "data"};
+        for (std::size_t c = 0; c < static_cast<std::size_t>(ESendClass::Count); ++c)
+        {
+            auto M = Scheduler.GetMetrics(static_cast<ESendClass>(c));
+            oss << " " << Names[c]
+                << " depth=" << M.QueueDepth
+                << " sent=" << M.Sent
+                << " bytes=" << M.SentBytes
+                << " avg_us=" << static_cast<uint64_t>(M.AvgLatencyUs)
+                << " max_us=" << static_cast<uint64_t>(M.MaxLatencyUs);
+        }
+        SessionObj->Send(oss.str());
+    }
+    else if (Command.starts_with("MEM_STATUS"))
+    {
+        // MEM_STATUS
+        // Process-wide memory budget: usage per category and transfers waiting for memory
+
+        MemoryBudget& Budget = MemoryBudget::Global();
+
+        std::ostringstream oss;
+        oss << "MEM_STATUS"
+            << " used=" << Budget.Used()
+            << " limit=" << Budget.Limit()
+            << " peak=" << Budget.Peak()
+            << " available=" << Budget.Available()
+            << " queued=" << PendingTransfers.size()
+            << " rejected=" << Budget.Rejected();
+        for (int c = 0; c < MEM_CATEGORY_COUNT; ++c)
+        {
+            auto Category = static_cast<MemoryCategory>(c);
+            oss << " " << MemoryCategoryName(Category) << "=" << Budget.Used(Category);
+        }
+        SessionObj->Send(oss.str());
+    }
+    else if (Command.starts_with("MEM_LIMIT "))
+    {
+        // MEM_LIMIT <bytes>
+        // Change the budget (at least MinMemoryLimit); raising it admits queued transfers on the next tick; admin only
+
+        if (!RequireAdmin(SessionObj, "MEM_LIMIT"))
+            return;
+
+        CommandReader args(Command);
+        std::string cmd;
+        uint64_t limitBytes = 0;
+
+        args >> cmd >> limitBytes;
+        if (args)
+            MemoryBudget::Global().SetLimit(std::max(limitBytes, MinMemoryLimit));
+    }
+    else if (Command.starts_with("TRACE_DUMP "))
+    {
+        // TRACE_DUMP <file_name>
+        // Write every thread's trace ring as Chrome/Perfetto JSON into TraceDirectory; replies the event count (-1 on failure)
+        // Without UDPTCP_TRACE=1 the file is valid but empty; admin only
+
+        if (!RequireAdmin(SessionObj, "TRACE_DUMP"))
+            return;
+
+        CommandReader args(Command);
+        std::string cmd, name;
+
+        if (!(args >> cmd >> name))
+            return;
+
+        /** A bare file name only: no directories, no hidden files, no "." / ".." */
+        if (name.find('/') != std::string::npos || name.starts_with('.'))
+        {
+            SessionObj->Send("TRACE_DUMP -1");
+            return;
+        }
+
+        std::string path = (std::filesystem::path(TraceDirectory) / name).string();
+        SessionObj->Send("TRACE_DUMP " + std::to_string(TraceDumpChrome(path)));
+    }
+    else if (Command.starts_with("NOTIFY_INTERVAL "))
+    {
+        // NOTIFY_INTERVAL <ms>
+        // How long observer events are coalesced before one EVENTS broadcast (0 = every tick, at most MaxNotifyIntervalMs); admin only
+
+        if (!RequireAdmin(SessionObj, "NOTIFY_INTERVAL"))
+            return;
+
+        CommandReader args(Command);
+        std::string cmd;
+        uint32_t intervalMs = 0;
+
+        args >> cmd >> intervalMs;
+        if (args)
+            NotifyInterval = std::chrono::milliseconds(std::min(intervalMs, MaxNotifyIntervalMs));
+    }
+}
+
+// ------------------------------------
+// UDP Send
+// ------------------------------------
+
+void TCPController::SendPacketStream(uint64_t FlowId, uint64_t SessionId, const SharedPackets& Packets, const std::vector<bool>& Wanted,
+                                     const SharedPackets& Parity, uint32_t FecK, uint32_t FecM,
+                                     const std::vector<sockaddr_in>& Destinations, ESendClass Class)
+{
+    /** Queue the wanted packets in order: zero runs coalesced, FEC parity after each group */
+
+    uint64_t TotalPackets = Packets->size();
+    bool HasParity = Parity && !Parity->empty();
+
+    SendItem Item;
+    Item.FlowId = FlowId;
+    Item.SessionId = SessionId;
+    Item.TotalPackets = TotalPackets;
+    Item.Destinations = std::make_shared<const std::vector<sockaddr_in>>(Destinations);
+
+    bool groupSent = false;
+    for (uint64_t i = 0; i < TotalPackets; ++i)
+    {
+        const Packet& Pkt = (*Packets)[i];
+
+        if (Wanted[i] && (Pkt.flags & PACKET_FLAG_ZERO))
+        {
+            /** Coalesce a run of zero chunks into one range marker (never across an FEC group) */
+            uint64_t limit = !HasParity ? TotalPackets
+                                        : std::min<uint64_t>(TotalPackets, (i / FecK + 1) * FecK);
+            uint64_t end = i + 1;
+            while (end < limit && Wanted[end] && ((*Packets)[end].flags & PACKET_FLAG_ZERO))
+                ++end;
+
+            Item.Kind = SendItem::EKind::ZeroRange;
+            Item.Packets = Packets;
+            Item.Index = i;
+            Item.End = end;
+            Item.Bytes = UDP_HEADER_BYTES + ZERO_RANGE_MARKER_BYTES;
+            Scheduler.Enqueue(Class, Item);
+            groupSent = true;
+            i = end - 1;
+        }
+        else if (Wanted[i])
+        {
+            Item.Kind = SendItem::EKind::Data;
+            Item.Packets = Packets;
+            Item.Index = i;
+            Item.Bytes = UDP_HEADER_BYTES + Pkt.length;
+            Scheduler.Enqueue(Class, Item);
+            groupSent = true;
+        }
+
+        /** Parity of a group follows its last data chunk (index = total + parity seq) */
+        bool groupEnd = HasParity && ((i + 1) % FecK == 0 || i + 1 == TotalPackets);
+        if (groupEnd)
+        {
+            uint64_t group = i / FecK;
+            for (uint32_t j = 0; groupSent && j < FecM; ++j)
+            {
+                Item.Kind = SendItem::EKind::Parity;
+                Item.Packets = Parity;
+                Item.Index = group * FecM + j;
+                Item.Bytes = UDP_HEADER_BYTES + (*Parity)[Item.Index].length;
+                Scheduler.Enqueue(Class, Item);
+            }
+            groupSent = false;
+        }
+    }
+}
+
+void TCPController::EnqueueMessage(uint64_t FlowId, SessionHandle TargetSession, const std::string& Message, ESendClass Class)
+{
+    /** Control message ordered behind the flow's queued datagrams */
+
+    SendItem Item;
+    Item.Kind = SendItem::EKind::Message;
+    Item.FlowId = FlowId;
+    Item.TargetSession = TargetSession;
+    Item.Text = Message;
+    Scheduler.Enqueue(Class, std::move(Item));
+}
+
+void TCPController::SendListInParts(Session* SessionObj, const std::string& Header, const std::string& List, char Separator)
+{
+    /** Cut at the last separator that fits; a single item longer than a part still goes whole */
+
+    std::size_t Pos = 0;
+    for (uint64_t Part = 0;; ++Part)
+    {
+        std::size_t End = List.size();
+        if (End - Pos > MaxListPartBytes)
+        {
+            End = List.rfind(Separator, Pos + MaxListPartBytes);
+            if (End == std::string::npos || End <= Pos)
+                End = std::min(List.find(Separator, Pos + MaxListPartBytes), List.size());
+        }
+
+        bool bLast = End >= List.size();
+        SessionObj->SendPaced(Header + " " + std::to_string(Part) + (bLast ? " LAST " : " MORE ")
+                              + List.substr(Pos, End - Pos));
+        if (bLast)
+            return;
+
+        Pos = End + 1;
+    }
+}
+
+bool TCPController::PumpSendQueue()
+{
+    /** Drain what the scheduler releases this round (bounded so commands keep flowing) */
+
+    auto Now = SendScheduler::Clock::now();
+
+    SendItem Item;
+    for (int Sent = 0; Sent < MaxSendsPerUpdate; ++Sent)
+    {
+        if (!Scheduler.Dequeue(Now, Item))
+            return false;
+
+        // Queueing delay = pacing + fairness wait (resend latency for Retransmit items)
+        TRACE_INSTANT("SendQueueWait", std::chrono::duration_cast<std::chrono::microseconds>(Now - Item.Enqueued).count());
+        TransmitItem(Item);
+    }
+    return true;
+}
+
+void TCPController::TransmitItem(const SendItem& Item)
+{
+    /** Materialize a queued item into a datagram or TCP message */
+
+    if (!ArmRetransmitTimer(Item))
+        return;
+
+    switch (Item.Kind)
+    {
+    case SendItem::EKind::Message:
+        SendToSession(Item.TargetSession, Item.Text);
+        break;
+
+    case SendItem::EKind::Data:
+        SendUdpPacket(Item.SessionId, Item.Index, (*Item.Packets)[Item.Index], Item.TotalPackets, *Item.Destinations,
+                      Item.Index + 1 == Item.TotalPackets ? UDP_FLAG_LAST_CHUNK : 0);
+        break;
+
+    case SendItem::EKind::ZeroRange:
+        SendUdpPacket(Item.SessionId, Item.Index,
+                      FileSplitterAndMerger::BuildZeroRangePacket(*Item.Packets, Item.Index, Item.End),
+                      Item.TotalPackets, *Item.Destinations,
+                      Item.End == Item.TotalPackets ? UDP_FLAG_LAST_CHUNK : 0);
+        break;
+
+    case SendItem::EKind::Parity:
+    {
+        const Packet& P = (*Item.Packets)[Item.Index];
+        SendUdpPacket(Item.SessionId, Item.TotalPackets + P.seq, P, Item.TotalPackets, *Item.Destinations,
+                      UDP_FLAG_PARITY);
+        break;
+    }
+    }
+}
+
+void TCPController::SendUdpPacket(uint64_t SessionId, uint64_t PacketIndex, const Packet& Pkt, uint64_t TotalPackets,
+                                  const std::vector<sockaddr_in>& Destinations, uint8_t WireFlags)
+{
+    /** Build header + payload into a single datagram (header encoded big-endian in place) */
+
+    TRACE_SCOPE("SendUdpPacket", PacketIndex);
+
+    UdpPacketHeader Header{};
+    Header.session_id = SessionId;
+    Header.packet_index = PacketIndex;
+    Header.total_packets = TotalPackets;
+    Header.data_length = Pkt.length;
+    Header.flags = Pkt.flags | WireFlags;
+
+    std::vector<unsigned char> Datagram(UDP_HEADER_BYTES + Pkt.length);
+    SealUdpPacketHeader(Header, Pkt.checksum, Datagram.data());
+    memcpy(Datagram.data() + UDP_HEADER_BYTES, Pkt.data.data(), Pkt.length);
+
+    if (Destinations.size() == 1)
+    {
+        sendto(UdpSocket, Datagram.data(), Datagram.size(), 0,
+               (const sockaddr*)&Destinations[0], sizeof(sockaddr_in));
+        return;
+    }
+
+    /** Fan-out: same datagram to every destination in one batched syscall */
+    iovec Iov{Datagram.data(), Datagram.size()};
+    std::vector<mmsghdr> Messages(Destinations.size());
+    for (std::size_t d = 0; d < Destinations.size(); ++d)
+    {
+        Messages[d].msg_hdr.msg_name = const_cast<sockaddr_in*>(&Destinations[d]);
+        Messages[d].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        Messages[d].msg_hdr.msg_iov = &Iov;
+        Messages[d].msg_hdr.msg_iovlen = 1;
+    }
+
+    for (std::size_t Sent = 0; Sent < Messages.size(); )
+    {
+        int Count = sendmmsg(UdpSocket, Messages.data() + Sent, Messages.size() - Sent, 0);
+        if (Count <= 0)
+            break;
+        Sent += Count;
+    }
+}
+
+// ------------------------------------
+// Sender-side Retransmission
+// ------------------------------------
+
+uint64_t TCPController::NowUs() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(SendScheduler::Clock::now() - TimerEpoch).count();
+}
+
+void TCPController::BeginReliableTransfer(uint64_t SessionId, const SharedPackets& Packets, const std::vector<bool>& Wanted,
+                                          const std::string& DoneMessage)
+{
+    /** Packets not sent this time count as acknowledged */
+
+    EndReliableTransfer(SessionId);
+
+    ReliableTransfer& Transfer = ReliableTransfers[SessionId];
+    Transfer.Packets = Packets;
+    Transfer.Timers.assign(Packets->size(), TimerWheel::INVALID_TIMER);
+    Transfer.SentAtUs.assign(Packets->size(), 0);
+    Transfer.Retries.assign(Packets->size(), 0);
+    Transfer.Acked.resize(Wanted.size());
+    for (std::size_t i = 0; i < Wanted.size(); ++i)
+        Transfer.Acked[i] = !Wanted[i];
+    Transfer.DoneMessage = DoneMessage;
+}
+
+void TCPController::EndReliableTransfer(uint64_t SessionId)
+{
+    auto It = ReliableTransfers.find(SessionId);
+    if (It == ReliableTransfers.end())
+        return;
+
+    for (TimerWheel::TimerId Id : It->second.Timers)
+        RetransmitTimers.Cancel(Id);
+    RetransmitTimers.Cancel(It->second.DoneTimer);
+
+    ReliableTransfers.erase(It);
+}
+
+bool TCPController::ArmRetransmitTimer(const SendItem& Item)
+{
+    /** Only items of a tracked transfer (same shared packet list / its done message) get timers */
+
+    auto It = ReliableTransfers.find(Item.FlowId);
+    if (It == ReliableTransfers.end())
+        return true;
+    ReliableTransfer& Transfer = It->second;
+
+    uint64_t Now = NowUs();
+    uint64_t NowTick = Now / 1000;
+
+    // Only the slot fits next to the packet index; the handle is recovered from the table on expiry
+    uint64_t TimerKey = static_cast<uint64_t>(SessionTable::SlotOf(Item.FlowId)) << 32;
+
+    if (Item.Kind == SendItem::EKind::Message)
+    {
+        if (Item.Text == Transfer.DoneMessage && Item.TargetSession == Item.FlowId)
+        {
+            RetransmitTimers.Cancel(Transfer.DoneTimer);
+            uint64_t Expire = NowTick + Transfer.Rtt.RtoUs(Transfer.DoneRetries) / 1000 + 1;
+            Transfer.DoneTimer = RetransmitTimers.Schedule(Expire, TimerKey | DoneTimerIndex);
+        }
+        return true;
+    }
+
+    if (Item.Packets != Transfer.Packets || Item.Kind == SendItem::EKind::Parity)
+        return true;
+
+    if (!Transfer.Destinations)
+        Transfer.Destinations = Item.Destinations;
+
+    uint64_t Begin = Item.Index;
+    uint64_t End = (Item.Kind == SendItem::EKind::ZeroRange) ? Item.End : Item.Index + 1;
+
+    /** A queued resend that was acknowledged in the meantime is dropped */
+    if (Item.Kind == SendItem::EKind::Data && Transfer.Acked[Begin])
+        return false;
+
+    for (uint64_t i = Begin; i < End; ++i)
+    {
+        if (Transfer.Acked[i])
+            continue;
+
+        RetransmitTimers.Cancel(Transfer.Timers[i]);
+        uint64_t Expire = NowTick + Transfer.Rtt.RtoUs(Transfer.Retries[i]) / 1000 + 1;
+        Transfer.Timers[i] = RetransmitTimers.Schedule(Expire, TimerKey | i);
+        Transfer.SentAtUs[i] = (Transfer.Retries[i] == 0) ? Now : 0;
+    }
+    return true;
+}
+
+void TCPController::ProcessRetransmitTimers()
+{
+    /** Expired timers: resend ahead of new data, with exponential backoff on the next RTO */
+
+    std::vector<uint64_t> Expired;
+    RetransmitTimers.Advance(NowUs() / 1000, Expired);
+
+    for (uint64_t UserData : Expired)
+    {
+        SessionHandle SessionId = Sessions.HandleAt(static_cast<uint32_t>(UserData >> 32));
+        uint64_t Index = UserData & 0xFFFFFFFFull;
+
+        auto It = ReliableTransfers.find(SessionId);
+        if (It == ReliableTransfers.end())
+            continue;
+        ReliableTransfer& Transfer = It->second;
+
+        if (Index == DoneTimerIndex)
+        {
+            Transfer.DoneTimer = TimerWheel::INVALID_TIMER;
+            if (++Transfer.DoneRetries <= MaxRetransmits)
+                EnqueueMessage(SessionId, SessionId, Transfer.DoneMessage, ESendClass::Retransmit);
+            continue;
+        }
+
+        Transfer.Timers[Index] = TimerWheel::INVALID_TIMER;
+        if (Transfer.Acked[Index] || Transfer.Retries[Index] >= MaxRetransmits)
+            continue;
+
+        TRACE_INSTANT("RetransmitTimeout", Index);
+        ++Transfer.Retries[Index];
+
+        SendItem Item;
+        Item.FlowId = SessionId;
+        Item.SessionId = SessionId;
+        Item.Packets = Transfer.Packets;
+        Item.Index = Index;
+        Item.TotalPackets = Transfer.Packets->size();
+        Item.Destinations = Transfer.Destinations;
+        Item.Bytes = UDP_HEADER_BYTES + (*Transfer.Packets)[Index].length;
+        Scheduler.Enqueue(ESendClass::Retransmit, std::move(Item));
+    }
+}
+
+std::vector<sockaddr_in> TCPController::FanoutDestinations(const FanoutChannel& Channel) const
+{
+    /** Multicast group, or every joined receiver */
+
+    if (Channel.Multicast)
+        return {Channel.GroupAddr};
+
+    std::vector<sockaddr_in> Destinations;
+    Destinations.reserve(Channel.Receivers.size());
+    for (const auto& Pair : Channel.Receivers)
+        Destinations.push_back(Pair.second);
+    return Destinations;
+}
+
+void TCPController::FlushFanoutRepairs()
+{
+    /** One shared repair round per channel, covering the union of all receivers' NACKs */
+
+    auto Now = std::chrono::steady_clock::now();
+
+    for (auto& [ChannelId, Channel] : FanoutChannels)
+    {
+        if (!Channel.RepairPending)
+        {
+            /** Every receiver has the whole file: the last round is over, give the packets (and their budget) back */
+            bool AllCompleted = std::ranges::all_of(Channel.Receivers, [&Channel](const auto& Pair) {
+                return Channel.Completed.contains(Pair.first);
+            });
+            if (Channel.Packets && AllCompleted)
+            {
+                Channel.Packets.reset();
+                Channel.RepairWanted.clear();
+                Channel.Reported.clear();
+            }
+            continue;
+        }
+
+        bool AllReported = Channel.Reported.size() >= Channel.Receivers.size();
+        if (!AllReported && Now < Channel.RepairDeadline)
+            continue;
+
+        SendPacketStream(Channel.FlowId, ChannelId, Channel.Packets, Channel.RepairWanted, nullptr, 0, 0,
+                         FanoutDestinations(Channel), ESendClass::Retransmit);
+
+        /** Receivers still missing packets NACK again after this */
+        for (SessionHandle Id : Channel.Reported)
+            EnqueueMessage(Channel.FlowId, Id, "FANOUT_REPAIR_DONE " + std::to_string(ChannelId), ESendClass::Retransmit);
+
+        Channel.RepairWanted.assign(Channel.Packets->size(), false);
+        Channel.RepairPending = false;
+        Channel.Reported.clear();
+    }
+}
+
+
+
+// ------------------------------------
+// Memory Budget / Admission
+// ------------------------------------
+
+bool TCPController::AdmitTransfer(Session* SessionObj, std::string_view Command)
+{
+    /** Only commands that load a file or directory into memory are gated */
+
+    // Already holds its reservation (admitted from the pending queue)
+    if (Admission.Bytes() > 0)
+        return true;
+
+    CommandReader args(Command);
+    std::string cmd, path;
+    uint64_t channelId;
+
+    if (Command.starts_with("FILE_SEND ") || Command.starts_with("FILE_SEND_CDC ") || Command.starts_with("DIR_SEND "))
+        args >> cmd >> path;
+    else if (Command.starts_with("FANOUT_SEND "))
+        args >> cmd >> channelId >> path;
+    else if (Command.starts_with("FILE_RANGE "))
+    {
+        // Range requests for an already split file reuse the cached packets
+        args >> cmd >> path;
+        if (RangeSourceCache.contains(path))
+            return true;
+    }
+    else
+        return true;
+
+    if (!args)
+        return true;
+
+    MemoryBudget& Budget = MemoryBudget::Global();
+    uint64_t Bytes = EstimateTransferBytes(path, FileChunkSize);
+
+    /** Could never fit: refuse instead of waiting forever */
+    if (Bytes > Budget.Limit())
+    {
+        SessionObj->Send("MEM_REJECTED " + cmd + " " + std::to_string(Bytes) + " " + std::to_string(Budget.Limit()));
+        return false;
+    }
+
+    // FIFO: a new request never overtakes one that is already waiting
+    if (PendingTransfers.empty())
+    {
+        if (Admission.TryGrow(Bytes))
+            return true;
+
+        // Cached splits give way before transfers have to wait
+        RangeSourceCache.clear();
+        if (Admission.TryGrow(Bytes))
+            return true;
+    }
+
+    PendingTransfers.push_back(PendingTransfer{SessionObj->GetId(), std::string(Command), Bytes});
+    SessionObj->Send("MEM_QUEUED " + cmd + " " + std::to_string(PendingTransfers.size()) + " "
+                     + std::to_string(Bytes) + " " + std::to_string(Budget.Available()));
+    return false;
+}
+
+void TCPController::AdmitPendingTransfers()
+{
+    /** Strict arrival order: the head waits until it fits, so a large request is not starved by small ones */
+
+    while (!PendingTransfers.empty())
+    {
+        PendingTransfer& Head = PendingTransfers.front();
+
+        Session* SessionObj = Sessions.Get(Head.Handle);
+        if (SessionObj == nullptr || SessionObj->IsAborted())
+        {
+            PendingTransfers.pop_front();
+            continue;
+        }
+
+        if (!Admission.TryGrow(Head.Bytes))
+            return;
+
+        PendingTransfer Admitted = std::move(Head);
+        PendingTransfers.pop_front();
+        ProcessCommand(SessionObj, Admitted.Command);
+    }
+}
+
+SharedPackets TCPController::AccountPackets(std::vector<Packet>&& Packets, MemoryCategory Category)
+{
+    /** Charge the real size; the admission estimate shrinks by the same amount */
+
+    uint64_t Bytes = PacketMemoryBytes(Packets);
+    Admission.Resize(Admission.Bytes() > Bytes ? Admission.Bytes() - Bytes : 0);
+
+    auto Holder = std::make_shared<AccountedPackets>();
+    Holder->Packets = std::move(Packets);
+    Holder->Reservation = MemoryReservation(Category);
+    Holder->Reservation.Resize(Bytes);
+
+    // Aliasing constructor: callers see the vector, the control block also owns the reservation
+    return SharedPackets(Holder, &Holder->Packets);
+}
+
+// ------------------------------------
+// Session Sweep
+// ------------------------------------
+
+void TCPController::DestroySession(SessionHandle Handle)
+{
+    /** Drop per-session transfer state before the slot (and handle generation) is recycled */
+
+    EndReliableTransfer(Handle);
+    SentPacketCache.erase(Handle);
+    ManifestDigestCache.erase(Handle);
+    ClientUdpAddrs.erase(Handle);
+    AdminSessions.erase(Handle);
+    Scheduler.RemoveFlow(Handle);
+
+    for (auto It = FanoutChannels.begin(); It != FanoutChannels.end();)
+    {
+        FanoutChannel& Channel = It->second;
+        Channel.Receivers.erase(Handle);
+        Channel.Reported.erase(Handle);
+        Channel.Completed.erase(Handle);
+
+        /** Nobody left to deliver to: drop the channel's queued datagrams and the channel itself */
+        if (Channel.Receivers.empty())
+        {
+            Scheduler.RemoveFlow(Channel.FlowId);
+            It = FanoutChannels.erase(It);
+        }
+        else
+            ++It;
+    }
+
+    Sessions.Destroy(Handle);
+}
+
+// ------------------------------------
+// Observer Event Receiver
+// ------------------------------------
+
+void TCPController::OnNotifyEvent(const std::string& EventName, const std::string& Payload)
+{
+    /** Coalesce: keep only the latest payload per event name until the next flush */
+
+    ++PendingEventCount;
+    SendWork.Notify();
+
+    for (auto& Event : PendingEvents)
+    {
+        if (Event.first == EventName)
+        {
+            Event.second = Payload;
+            return;
+        }
+    }
+
+    PendingEvents.emplace_back(EventName, Payload);
+}
+
+void TCPController::FlushNotifications()
+{
+    /** One broadcast per interval, however many events arrived */
+
+    if (PendingEvents.empty())
+        return;
+
+    auto Now = SendScheduler::Clock::now();
+    if (Now < NextNotifyTime)
+        return;
+
+    NextNotifyTime = Now + NotifyInterval;
+
+    // EVENTS <event_count>
+    // <EventName>:<Payload>  (one line per distinct event)
+    std::string Message = "EVENTS " + std::to_string(PendingEventCount);
+    for (const auto& Event : PendingEvents)
+    {
+        Message += '\n';
+        Message += Event.first;
+        Message += ':';
+        Message += Event.second;
+    }
+
+    PendingEvents.clear();
+    PendingEventCount = 0;
 
-    std::string Combined = EventName + ":" + Payload;
-    Broadcast(Combined);
+    Broadcast(Message);
 }
@@ -1,7 +1,27 @@
 #pragma once
 #include "ITCPController.h"
 #include "Session.h"
+#include "SessionTable.h"
+#include "FileSplitterAndMerger.h"
+#include "UdpPacketHeader.h"
+#include "PacketRange.h"
+#include "SendScheduler.h"
+#include "ControlFrame.h"
+#include "ZeroRange.h"
+#include "TimerWheel.h"
+#include "RttEstimator.h"
+#include "Reactor.h"
+#include "MemoryBudget.h"
+
+#include <deque>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <string_view>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 /** TCP 연결을 관리하는 컨트롤러 클래스
     세션 생성, 메시지 전송, 이벤트 수신 등을 담당
@@ -9,10 +29,14 @@
 class TCPController : public ITCPController
 {
 public:
+    /** 기본 TCP 리슨 포트 */
+    static constexpr uint16_t DefaultListenPort = 7777;
+
     /** 생성자
         내부 상태 초기화
+        @input InListenPort TCP 리슨 포트 (한 호스트에서 서버를 여러 개 띄울 때 서로 다르게)
     */
-    TCPController();
+    explicit TCPController(uint16_t InListenPort = DefaultListenPort);
 
     /** 소멸자
         Shutdown() 호출하여 모든 세션 정리
@@ -20,7 +44,7 @@ public:
     virtual ~TCPController();
 
     /** TCP 컨트롤러 초기화
-        TCP 시스템 준비 작업 수행
+        TCP 시스템 준비 작업 수행 후 연결 수락 / 전송 코루틴을 리액터에 등록
         @return 성공 시 true, 실패 시 false
     */
     virtual bool Init() override;
@@ -31,32 +55,459 @@ public:
     virtual void Shutdown() override;
 
     /** 새로운 사용자 세션 생성
-        @input ConnectionId 세션 고유 아이디
+        세션 테이블 슬롯에 만들고 GetId() 로 세대가 붙은 핸들을 돌려줌
+        @input ConnectionId 수락한 클라이언트 소켓
         @return 생성된 세션 객체
     */
     virtual ISession* CreateSession(int32 ConnectionId) override;
 
     /** 특정 세션에 메시지 전송
-        @input SessionId 대상 세션 아이디
+        @input SessionId 대상 세션 핸들 (이미 끊긴 세션이면 무시)
         @input Message 전송할 메시지
     */
-    virtual void SendToSession(int32 SessionId, const std::string& Message) override;
+    virtual void SendToSession(SessionHandle SessionId, const std::string& Message) override;
 
     /** 모든 세션에 메시지 브로드캐스트
+        프레임 버퍼 하나를 모든 세션의 송신 큐가 공유
+        송신 큐가 하이 워터 마크를 넘은 세션은 건너뜀
         @input Message 전송할 메시지
     */
     virtual void Broadcast(const std::string& Message) override;
 
     /** 외부 모델에서 TCP로 옵저버 이벤트 전달
+        바로 보내지 않고 NotifyInterval 동안 모아서 한 메시지로 브로드캐스트
+        같은 이름의 이벤트는 마지막 값만 남김 (진행률처럼 최신 값만 의미 있는 이벤트용)
         @input EventName 이벤트 이름
         @input Payload 이벤트 데이터
     */
     virtual void OnNotifyEvent(const std::string& EventName, const std::string& Payload) override;
 
+    /** 대기 중인 TCP 연결 하나 수락
+        수락된 소켓으로 세션 생성 후 "SESSION <핸들>" 전송하고 세션 코루틴 시작
+        (클라이언트는 이 값을 UDP session_id 로 사용)
+        @return 수락했으면 true, 대기 중인 연결이 없으면 false
+    */
+    bool AcceptClient();
+
+    /** 리액터를 한 번 돌림 (블로킹하지 않음)
+        직접 루프를 도는 쪽에서 매 틱 호출
+    */
+    void Update();
+
+    /** Shutdown 전까지 이벤트 루프 실행 (블로킹) */
+    void Run();
+
+    /** 관리 명령 인증 토큰 설정
+        프로세스 전체 설정을 바꾸는 명령(SEND_RATE, MEM_LIMIT, TRACE_DUMP, NOTIFY_INTERVAL)은 "ADMIN <토큰>" 으로 인증한 세션만 사용 가능
+        빈 문자열이면 관리 명령을 모두 거부 (기본값: 환경 변수 UDPTCP_ADMIN_TOKEN)
+        @input Token 인증 토큰
+    */
+    void SetAdminToken(const std::string& Token);
+
+    /** TRACE_DUMP 가 파일을 쓰는 디렉터리 설정 (기본값: 현재 디렉터리)
+        클라이언트는 이 디렉터리 안의 파일 이름만 고를 수 있음
+        @input Directory 덤프 디렉터리
+    */
+    void SetTraceDirectory(const std::string& Directory);
+
 private:
-    /** 현재 활성화된 모든 세션을 저장하는 컨테이너
+    /** 하나의 파일을 여러 클라이언트에게 동시에 보내는 팬아웃 채널
+        파일은 한 번만 분할/압축하고, 각 데이터그램은 멀티캐스트 그룹이나
+        참가자 전체에게 한 번에 전송
+    */
+    struct FanoutChannel
+    {
+        /** 참가 세션 -> 그 세션의 UDP 주소 */
+        std::unordered_map<SessionHandle, sockaddr_in> Receivers;
+
+        /** 채널을 만든 세션 (처음 FANOUT_JOIN 한 세션) */
+        SessionHandle Owner = InvalidSessionHandle;
+
+        /** DRR 흐름 아이디 (컨트롤러가 채널마다 발급, 세션 핸들과 겹치지 않음) */
+        uint64_t FlowId = 0;
+
+        /** 멀티캐스트 그룹으로 보낼지 여부와 그룹 주소 */
+        bool Multicast = false;
+        sockaddr_in GroupAddr{};
+
+        /** 현재 전송 중인 파일 (wire 형태) 과 전체 다이제스트 */
+        SharedPackets Packets;
+        uint32_t Digest = 0;
+
+        /** 수신자들의 NACK 을 합친 다음 수리 라운드 대상 */
+        std::vector<bool> RepairWanted;
+        bool RepairPending = false;
+
+        /** 이번 라운드에 응답(NACK 또는 완료)한 수신자 */
+        std::unordered_set<SessionHandle> Reported;
+
+        /** 파일을 다 받았다고 알린 (빈 FANOUT_NACK) 수신자 - 전원이 모이면 Packets 를 놓음 */
+        std::unordered_set<SessionHandle> Completed;
+
+        /** 이 시각이 지나면 응답이 덜 모였어도 수리 라운드 전송 */
+        std::chrono::steady_clock::time_point RepairDeadline;
+    };
+
+    /** 연결 수락 코루틴 (리슨 소켓이 준비될 때마다 깨어남) */
+    Task AcceptLoop();
+
+    /** 세션 코루틴
+        송신 큐를 비우고 명령을 읽어 처리한 뒤 소켓에 변화가 생길 때까지 잠듦
+        연결이 끊기면 세션을 정리하고 끝남
+        @input Handle 세션 핸들
+    */
+    Task SessionLoop(SessionHandle Handle);
+
+    /** 전송 코루틴
+        모든 전송은 DRR 스케줄러의 흐름으로 섞여 나가므로 전송마다 코루틴을 두지 않음
+        보낼 것이 없으면 SendWork 신호를 기다림 (타이머 등 시간이 정해진 일이 있으면 그 시각까지만)
+        속도 제한에 걸려 있을 때만 1ms 씩 잠듦
+    */
+    Task TransferLoop();
+
+    /** 세션 소켓에서 읽을 수 있는 만큼 읽고 완성된 명령을 모두 처리
+        @input SessionObj 세션
+        @return 연결이 끊겼거나 프로토콜 오류면 false
+    */
+    bool ReadCommands(Session* SessionObj);
+
+    /** 시간이 지나야 진행되는 일(재전송 타이머, 팬아웃 수리 대기, 모아 둔 알림, 예산 대기) 중
+        가장 이른 것까지 남은 시간
+        @return 남은 ms (이미 지났으면 0), 그런 일이 없으면 NoTimedWork
+    */
+    uint64_t NextTimedWorkMs() const;
+
+    /** 명령 하나 처리
+        파일을 읽어 들이는 전송 명령은 메모리 예산부터 받고, 예산이 모자라면 대기열에 넣음
+        @input SessionObj 명령을 보낸 세션
+        @input Command 수신한 명령 문자열 (세션 수신 버퍼를 직접 가리킴)
+    */
+    void ProcessCommand(Session* SessionObj, std::string_view Command);
+
+    /** 관리 명령 권한 확인 (없으면 "ADMIN_REQUIRED <명령>" 전송)
+        @input SessionObj 명령을 보낸 세션
+        @input Command 명령 이름
+        @return ADMIN 으로 인증한 세션이면 true
+    */
+    bool RequireAdmin(Session* SessionObj, std::string_view Command);
+
+    /** 명령 문자열에 따라 동작 분기
+        @input SessionObj 명령을 보낸 세션
+        @input Command 수신한 명령 문자열
+    */
+    void DispatchCommand(Session* SessionObj, std::string_view Command);
+
+    /** 전송 명령의 메모리 예산 확인 (Admission 에 예약)
+        예산이 모자라면 PendingTransfers 에 넣고 "MEM_QUEUED", 한도보다 크면 "MEM_REJECTED" 전송
+        @input SessionObj 명령을 보낸 세션
+        @input Command 명령 문자열
+        @return 지금 실행해도 되면 true (전송 명령이 아니어도 true)
+    */
+    bool AdmitTransfer(Session* SessionObj, std::string_view Command);
+
+    /** 예산이 생긴 만큼 대기 중인 전송 명령을 들어온 순서대로 실행 (매 틱 호출) */
+    void AdmitPendingTransfers();
+
+    /** 분할한 패킷을 메모리 예산에 올려 공유 목록으로 만듦
+        예약은 목록과 함께 해제되므로 마지막 큐 항목 / 캐시가 놓는 순간 예산이 돌아옴
+        @input Packets 분할 결과
+        @input Category 예산 카테고리
+        @return 전송 / 캐시에 쓸 공유 목록
+    */
+    SharedPackets AccountPackets(std::vector<Packet>&& Packets, MemoryCategory Category = MEM_SEND_BUFFERS);
+
+    /** 패킷 목록 중 Wanted 인 것들을 순서대로 전송 큐에 넣음
+        연속된 0 청크는 구간 표식 하나로 묶고, FEC 패리티는 각 그룹 뒤에 배치
+        실제 전송은 PumpSendQueue 가 다른 전송들과 섞어서 수행
+        @input FlowId DRR 흐름 아이디 (요청한 세션 또는 팬아웃 채널)
+        @input SessionId UDP 헤더의 session_id
+        @input Packets 전송할 패킷 목록 (index = packet_index)
+        @input Wanted 패킷별 전송 여부
+        @input Parity FEC 패리티 패킷 (없으면 nullptr)
+        @input FecK 그룹당 데이터 청크 수
+        @input FecM 그룹당 패리티 청크 수
+        @input Destinations 받을 UDP 주소 목록 (멀티캐스트면 그룹 주소 하나)
+        @input Class 우선순위 클래스 (재전송 라운드는 Retransmit)
+    */
+    void SendPacketStream(uint64_t FlowId, uint64_t SessionId, const SharedPackets& Packets, const std::vector<bool>& Wanted,
+                          const SharedPackets& Parity, uint32_t FecK, uint32_t FecM,
+                          const std::vector<sockaddr_in>& Destinations, ESendClass Class = ESendClass::Data);
+
+    /** TCP 메시지를 흐름의 전송 큐 뒤에 넣음
+        앞서 넣은 데이터그램이 모두 나간 뒤에 보내야 하는 완료 알림 등에 사용
+        @input FlowId 순서를 맞출 흐름 아이디
+        @input TargetSession 메시지를 받을 세션
+        @input Message 보낼 메시지
+        @input Class 우선순위 클래스
+    */
+    void EnqueueMessage(uint64_t FlowId, SessionHandle TargetSession, const std::string& Message,
+                        ESendClass Class = ESendClass::Data);
+
+    /** 긴 목록을 항목 경계에서 잘라 번호 붙은 조각으로 보냄 (FILE_MANIFEST / DIR_INDEX)
+        "<Header> <part> <MORE|LAST> <items>" 형태, 조각마다 그 자체로 디코딩 가능한 목록
+        송신 큐가 빠지는 만큼씩 나가므로 세션 송신 한도를 넘지 않음
+        @input SessionObj 받을 세션
+        @input Header 명령과 고정 인자 (예: "FILE_MANIFEST <count>")
+        @input List 구분자로 이어 붙인 목록
+        @input Separator 항목 구분자
+    */
+    void SendListInParts(Session* SessionObj, const std::string& Header, const std::string& List, char Separator);
+
+    /** 전송 큐에서 보낼 수 있는 만큼 꺼내 전송
+        한 번에 MaxSendsPerUpdate 개까지만 보내서 명령 처리가 밀리지 않게 함
+        @return 상한에 걸려 멈췄으면 true (바로 이어서 더 보낼 수 있음)
+    */
+    bool PumpSendQueue();
+
+    /** 재전송 추적 시작 (이전 전송이 있으면 정리)
+        @input SessionId 세션 아이디
+        @input Packets 전송할 패킷 목록
+        @input Wanted 이번에 보낼 패킷 (나머지는 이미 확인된 것으로 처리)
+        @input DoneMessage 확인될 때까지 다시 보낼 완료 알림
+    */
+    void BeginReliableTransfer(uint64_t SessionId, const SharedPackets& Packets, const std::vector<bool>& Wanted,
+                               const std::string& DoneMessage);
+
+    /** 재전송 추적 종료 (남은 타이머 모두 취소)
+        @input SessionId 세션 아이디
+    */
+    void EndReliableTransfer(uint64_t SessionId);
+
+    /** 추적 대상 항목이 전송될 때 RTO 타이머를 검
+        @input Item 방금 전송한 항목
+        @return 이미 확인된 패킷이라 보낼 필요가 없으면 false
+    */
+    bool ArmRetransmitTimer(const SendItem& Item);
+
+    /** 만료된 재전송 타이머 처리 (매 틱 호출)
+        확인되지 않은 패킷은 Retransmit 클래스로 다시 큐에 넣음
+    */
+    void ProcessRetransmitTimers();
+
+    /** TimerEpoch 기준 현재 시각 (us) */
+    uint64_t NowUs() const;
+
+    /** 큐 항목 하나를 실제로 전송
+        @input Item 전송할 항목
+    */
+    void TransmitItem(const SendItem& Item);
+
+    /** 단일 패킷을 UDP 데이터그램으로 전송
+        헤더에 CRC32C 체크섬을 채워 전송
+        데이터그램은 한 번만 만들고, 받는 곳이 여럿이면 sendmmsg 한 번으로 모두에게 보냄
+        @input SessionId 전송 세션 아이디
+        @input PacketIndex 패킷 번호
+        @input Pkt 전송할 패킷
+        @input TotalPackets 전체 패킷 개수
+        @input Destinations 받을 UDP 주소 목록
+        @input WireFlags 헤더에 더할 UDP_FLAG_* (패리티 / 마지막 청크)
+    */
+    void SendUdpPacket(uint64_t SessionId, uint64_t PacketIndex, const Packet& Pkt, uint64_t TotalPackets,
+                       const std::vector<sockaddr_in>& Destinations, uint8_t WireFlags = 0);
+
+    /** 끊긴 세션 정리 (세션 코루틴이 끝날 때 호출)
+        세션에 묶인 전송 캐시 / 재전송 타이머 / 팬아웃 참가 정보를 지우고 슬롯을 반납
+        큐에 남은 이 세션 앞 메시지는 핸들 세대가 맞지 않아 버려짐
+        @input Handle 세션 핸들
+    */
+    void DestroySession(SessionHandle Handle);
+
+    /** 모아 둔 옵저버 이벤트를 하나의 EVENTS 메시지로 브로드캐스트 (매 틱 호출)
+        NotifyInterval 이 지나지 않았으면 아무것도 하지 않음
+    */
+    void FlushNotifications();
+
+    /** 팬아웃 전송의 수신자별 데이터그램 목적지 목록
+        멀티캐스트 모드면 그룹 주소 하나, 아니면 참가한 모든 수신자 주소
+    */
+    std::vector<sockaddr_in> FanoutDestinations(const FanoutChannel& Channel) const;
+
+    /** 모아 둔 FANOUT_NACK 구간을 하나의 수리(repair) 라운드로 전송 (매 틱 호출)
+        모든 수신자가 응답했거나 대기 시간이 지난 채널만 전송
+    */
+    void FlushFanoutRepairs();
+
+    /** 파일 분할 단위 (UDP payload 크기) */
+    static constexpr std::size_t FileChunkSize = 1024;
+
+    /** 전송 코루틴이 한 번에 전송 큐에서 꺼내는 최대 항목 수 */
+    static constexpr int MaxSendsPerUpdate = 512;
+
+    /** 모든 전송을 섞어 내보내는 송신 스케줄러 (DRR + 우선순위 + 속도 제한) */
+    SendScheduler Scheduler;
+
+    /** 이벤트 루프 (세션 / 연결 수락 / 전송 코루틴) */
+    Reactor Io;
+
+    /** 전송 코루틴 깨우기 (명령 처리 / 옵저버 이벤트 후) */
+    Reactor::WakeSignal SendWork{Io};
+
+    /** TCP 리슨 소켓과 포트 */
+    int ListenSocket;
+    uint16_t ListenPort;
+
+    /** 파일 전송용 UDP 소켓 */
+    int UdpSocket;
+
+    /** 파일을 받을 클라이언트 UDP 주소 (FILE_SEND / FILE_SEND_CDC / DIR_SEND 가 기록)
+        key: 세션 ID
+        value: 그 세션의 UDP 주소 (재전송 / FILE_HAVE 응답도 여기로)
+    */
+    std::unordered_map<uint64_t, sockaddr_in> ClientUdpAddrs;
+
+    /** 재전송을 위한 세션별 전송 패킷 캐시
         key: 세션 ID
-        value: 세션 객체
+        value: 분할된 패킷 목록
+    */
+    std::unordered_map<uint64_t, SharedPackets> SentPacketCache;
+
+    /** FILE_MANIFEST 를 보내고 FILE_HAVE 응답을 기다리는 세션의 파일 다이제스트
+        key: 세션 ID
+        value: 파일 전체 CRC32C
+    */
+    std::unordered_map<uint64_t, uint32_t> ManifestDigestCache;
+
+    /** FILE_RANGE 요청용으로 분할해 둔 파일
+        여러 서버가 같은 방식으로 나누므로 packet_index 가 서버와 상관없는 전역 번호가 됨
+    */
+    struct RangeSource
+    {
+        uint64_t Size = 0;
+        int64_t Mtime = 0;
+        SharedPackets Packets;
+        uint32_t Digest = 0;
+    };
+
+    /** 구간 요청을 받은 파일 캐시 (파일이 바뀌면 다시 분할)
+        key: 파일 이름
+        value: 분할 결과
+    */
+    std::unordered_map<std::string, RangeSource> RangeSourceCache;
+
+    /** 송신 측 재전송 상태 (FILE_SEND / FILE_HAVE / DIR_SEND 세션)
+        FILE_ACK 로 확인되지 않은 패킷은 RTO 가 지나면 다시 보내고,
+        완료 알림은 FILE_COMPLETE 를 받을 때까지 다시 보냄
+    */
+    struct ReliableTransfer
+    {
+        /** 전송 중인 패킷 목록 (큐 항목이 같은 목록을 가리키면 추적 대상) */
+        SharedPackets Packets;
+
+        /** 재전송을 보낼 UDP 주소 (첫 전송 때 기록) */
+        std::shared_ptr<const std::vector<sockaddr_in>> Destinations;
+
+        /** 패킷별 재전송 타이머 (없으면 INVALID_TIMER) */
+        std::vector<TimerWheel::TimerId> Timers;
+
+        /** RTT 표본용 전송 시각 (us, 재전송한 패킷은 0 -> 표본에서 제외) */
+        std::vector<uint64_t> SentAtUs;
+
+        /** 패킷별 재전송 횟수 (RTO 지수 백오프) */
+        std::vector<uint8_t> Retries;
+
+        /** 수신 확인된 패킷 (보낼 필요가 없는 패킷도 true) */
+        std::vector<bool> Acked;
+
+        RttEstimator Rtt;
+
+        /** FILE_COMPLETE 를 받을 때까지 다시 보낼 완료 알림 */
+        std::string DoneMessage;
+        TimerWheel::TimerId DoneTimer = TimerWheel::INVALID_TIMER;
+        uint32_t DoneRetries = 0;
+    };
+
+    /** 재전송 추적 중인 전송
+        key: 세션 핸들
+        value: 재전송 상태
+    */
+    std::unordered_map<uint64_t, ReliableTransfer> ReliableTransfers;
+
+    /** 모든 전송의 재전송 타이머 (1틱 = 1ms, 패킷마다 힙 타이머를 두지 않음)
+        userData = (세션 슬롯 번호 << 32) | 패킷 번호
+    */
+    TimerWheel RetransmitTimers;
+
+    /** 타이머 휠 틱 0 의 기준 시각 */
+    SendScheduler::Clock::time_point TimerEpoch;
+
+    /** 패킷/완료 알림 하나당 최대 재전송 횟수 (넘으면 클라이언트의 FILE_RESEND 에 맡김) */
+    static constexpr uint32_t MaxRetransmits = 8;
+
+    /** 완료 알림 타이머의 패킷 번호 자리 값 */
+    static constexpr uint64_t DoneTimerIndex = 0xFFFFFFFFull;
+
+    /** NextTimedWorkMs 가 기다릴 일이 없을 때 돌려주는 값 */
+    static constexpr uint64_t NoTimedWork = Reactor::WakeSignal::NoTimeout;
+
+    /** 예산을 기다리는 전송 명령을 다시 확인하는 주기 (예산은 다른 스레드에서도 돌아옴) */
+    static constexpr uint64_t AdmissionPollMs = 10;
+
+    /** FILE_MANIFEST / DIR_INDEX 조각 하나에 담는 최대 목록 길이 (받는 쪽 링 버퍼에 그대로 들어감) */
+    static constexpr std::size_t MaxListPartBytes = 32 * 1024;
+
+    /** NACK 을 모으는 최대 대기 시간 */
+    static constexpr std::chrono::milliseconds FanoutRepairHoldoff{50};
+
+    /** 다음 알림 주기에 보낼 옵저버 이벤트 (이벤트 이름, 마지막 값) - 들어온 순서 유지 */
+    std::vector<std::pair<std::string, std::string>> PendingEvents;
+
+    /** 이번 주기에 들어온 이벤트 수 (합쳐진 것 포함) */
+    uint64_t PendingEventCount = 0;
+
+    /** 이 시각 이후에 다음 EVENTS 메시지 전송 */
+    SendScheduler::Clock::time_point NextNotifyTime{};
+
+    /** 옵저버 이벤트를 모으는 간격 (NOTIFY_INTERVAL 로 변경) */
+    std::chrono::milliseconds NotifyInterval{100};
+
+    /** NOTIFY_INTERVAL 로 걸 수 있는 최대 간격 (이벤트가 사실상 끊기지 않도록) */
+    static constexpr uint32_t MaxNotifyIntervalMs = 10000;
+
+    /** 예산이 모자라 실행을 미룬 전송 명령 */
+    struct PendingTransfer
+    {
+        SessionHandle Handle = InvalidSessionHandle;
+        std::string Command;
+
+        /** 실행에 필요한 추정 메모리 */
+        uint64_t Bytes = 0;
+    };
+
+    /** 메모리 예산을 기다리는 전송 명령 (들어온 순서대로 실행) */
+    std::deque<PendingTransfer> PendingTransfers;
+
+    /** 지금 실행 중인 전송 명령이 받은 예산 (분할 결과에 옮겨 붙이고 남은 것은 명령이 끝나면 반납) */
+    MemoryReservation Admission;
+
+    /** 관리 명령 인증 토큰 (비어 있으면 관리 명령 사용 불가) */
+    std::string AdminToken;
+
+    /** ADMIN 으로 인증한 세션 */
+    std::unordered_set<SessionHandle> AdminSessions;
+
+    /** MEM_LIMIT 로 낮출 수 있는 최소 예산 (전송 하나는 돌 수 있도록) */
+    static constexpr uint64_t MinMemoryLimit = 16ull << 20;
+
+    /** TRACE_DUMP 출력 디렉터리 */
+    std::string TraceDirectory = ".";
+
+    /** SEND_RATE 로 걸 수 있는 최소 속도 (0 = 제한 없음은 허용) */
+    static constexpr uint64_t MinSendRate = 64 * 1024;
+
+    /** 팬아웃 채널 목록
+        key: 채널 번호 (UDP 헤더의 session_id 로도 사용)
+        value: 채널 상태
+    */
+    std::unordered_map<uint64_t, FanoutChannel> FanoutChannels;
+
+    /** 팬아웃 흐름 아이디 시작값 (최상위 비트를 세워 세션 핸들과 구분) */
+    static constexpr uint64_t FanoutFlowIdBase = 1ull << 63;
+
+    /** 다음 팬아웃 채널에 줄 DRR 흐름 아이디 */
+    uint64_t NextFanoutFlowId = FanoutFlowIdBase;
+
+    /** 현재 활성화된 모든 세션을 저장하는 슬랩 테이블
+        핸들(세대 + 슬롯)로 조회하므로 fd 가 재사용돼도 이전 세션과 섞이지 않음
     */
-    std::unordered_map<int32, ISession*> Sessions;
+    SessionTable Sessions;
 };
@@ -0,0 +1,150 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "FileSplitterAndMerger.h"
+#include "UDPModel.h"
+
+/**
+ * @brief FEC 오버헤드 확인용 main 함수 (손실률별 완료 시간, FEC 끔 / 켬)
+ *
+ * 1. 8 MiB 테스트 파일을 1024바이트 청크로 나누고, K/M 패리티를 만든다.
+ * 2. 데이터그램마다 정해진 확률로 버리면서 UDPModel 에 넣는다. (재현 가능하도록 고정 시드)
+ * 3. 한 라운드가 끝나면 GetMissingRanges 로 빠진 청크만 다시 보낸다. (FILE_RESEND 흉내)
+ * 4. 완료 시간은 링크 모델로 계산한다:
+ *      보낸 바이트 / 대역폭  +  재전송 라운드 수 x RTT
+ *    (첫 라운드도 마지막 청크의 ACK 까지 RTT 한 번)
+ *
+ * 사용법: FecLossmain [k] [m] [rtt_ms] [mbps]   (기본 16 2 100 100)
+ */
+namespace {
+
+constexpr uint32_t CHUNK_BYTES = 1024;
+constexpr uint64_t FILE_BYTES = 8ull << 20;
+
+struct RunResult {
+    uint64_t rounds = 0;     // 재전송 라운드 수 (첫 전송 제외)
+    uint64_t datagrams = 0;  // 보낸 데이터그램 수 (패리티 포함)
+    uint64_t bytes = 0;      // 보낸 바이트 수 (헤더 포함)
+    uint64_t recovered = 0;  // FEC 로 복원한 청크 수
+    bool complete = false;
+};
+
+// Packet 하나를 TCPController::SendUdpPacket 과 같은 모양의 데이터그램으로
+std::vector<unsigned char> MakeDatagram(uint64_t packetIndex, const Packet& pkt, uint64_t total, uint8_t wireFlags)
+{
+    UdpPacketHeader header{};
+    header.session_id = 1;
+    header.packet_index = packetIndex;
+    header.total_packets = total;
+    header.data_length = pkt.length;
+    header.flags = pkt.flags | wireFlags;
+
+    std::vector<unsigned char> datagram(UDP_HEADER_BYTES + pkt.length);
+    SealUdpPacketHeader(header, pkt.checksum, datagram.data());
+    std::copy(pkt.data.begin(), pkt.data.begin() + pkt.length, datagram.begin() + UDP_HEADER_BYTES);
+    return datagram;
+}
+
+RunResult Run(const std::vector<Packet>& packets, const std::vector<Packet>& parity,
+              uint32_t k, uint32_t m, double lossRate, uint32_t seed)
+{
+    RunResult result;
+    const uint64_t total = packets.size();
+
+    UDPModel model;
+    model.SetStatusCallback([&result](uint64_t, uint64_t, int status) {
+        if (status == UDP_PACKET_RECOVERED) ++result.recovered;
+    });
+    model.InitializeSession(1, total, "fec_loss_out.bin");
+    if (!parity.empty()) model.SetFecParams(k, m);
+
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution lost(lossRate);
+
+    auto deliver = [&](const std::vector<unsigned char>& datagram) {
+        ++result.datagrams;
+        result.bytes += datagram.size();
+        if (!lost(rng))
+            model.ProcessReceivedPacket(datagram.data(), static_cast<int>(datagram.size()));
+    };
+
+    // 첫 라운드: 데이터 + 그룹 끝마다 패리티 (송신 측 순서와 같게)
+    for (uint64_t i = 0; i < total; ++i) {
+        deliver(MakeDatagram(i, packets[i], total, i + 1 == total ? UDP_FLAG_LAST_CHUNK : 0));
+
+        bool groupEnd = !parity.empty() && ((i + 1) % k == 0 || i + 1 == total);
+        if (groupEnd) {
+            uint64_t group = i / k;
+            for (uint64_t j = group * m; j < (group + 1) * m && j < parity.size(); ++j)
+                deliver(MakeDatagram(total + parity[j].seq, parity[j], total, UDP_FLAG_PARITY));
+        }
+    }
+
+    // 재전송 라운드: 빠진 데이터 청크만 (재전송에는 패리티를 붙이지 않음)
+    while (!model.IsSessionComplete() && result.rounds < 100) {
+        ++result.rounds;
+        for (const PacketRange& range : model.GetMissingRanges())
+            for (uint64_t i = range.begin; i < range.end; ++i)
+                deliver(MakeDatagram(i, packets[i], total, i + 1 == total ? UDP_FLAG_LAST_CHUNK : 0));
+    }
+
+    result.complete = model.IsSessionComplete();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t k = argc > 1 ? std::atoi(argv[1]) : 16;
+    uint32_t m = argc > 2 ? std::atoi(argv[2]) : 2;
+    double rttMs = argc > 3 ? std::atof(argv[3]) : 100.0;
+    double mbps = argc > 4 ? std::atof(argv[4]) : 100.0;
+
+    // ============================================================
+    // 1) 테스트 파일 생성 + 분할 + 패리티
+    // ============================================================
+    {
+        std::ofstream f("fec_loss_in.bin", std::ios::binary);
+        std::mt19937 rng(7);
+        for (uint64_t i = 0; i < FILE_BYTES; ++i)
+            f.put(static_cast<char>(rng()));
+    }
+
+    FileSplitterAndMerger fsm;
+    std::vector<Packet> packets = fsm.SplitFile("fec_loss_in.bin", CHUNK_BYTES);
+    std::vector<Packet> parity = FileSplitterAndMerger::BuildParityPackets(packets, k, m);
+    if (packets.empty() || parity.empty()) {
+        std::cout << "split or parity failed\n";
+        return 1;
+    }
+
+    std::cout << "chunks " << packets.size() << ", FEC K=" << k << " M=" << m
+              << " (overhead " << 100.0 * m / k << "%), RTT " << rttMs << " ms, " << mbps << " Mbit/s\n";
+
+    // ============================================================
+    // 2) 손실률별로 FEC 끔 / 켬 비교
+    // ============================================================
+    const double lossRates[] = {0.0, 0.001, 0.005, 0.01, 0.02, 0.05};
+    const std::vector<Packet> noParity;
+
+    auto completionMs = [&](const RunResult& r) {
+        double transferMs = r.bytes * 8.0 / (mbps * 1000.0);
+        return transferMs + (r.rounds + 1) * rttMs;
+    };
+
+    for (double loss : lossRates) {
+        RunResult plain = Run(packets, noParity, k, m, loss, 42);
+        RunResult fec = Run(packets, parity, k, m, loss, 42);
+
+        std::cout << "loss " << loss * 100 << "%: "
+                  << "no FEC " << completionMs(plain) << " ms (" << plain.rounds << " rounds)"
+                  << " | FEC " << completionMs(fec) << " ms (" << fec.rounds << " rounds, "
+                  << fec.recovered << " recovered)"
+                  << ((plain.complete && fec.complete) ? "" : " INCOMPLETE") << "\n";
+    }
+
+    return 0;
+}
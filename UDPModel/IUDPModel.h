@@ -3,11 +3,65 @@
 
 #include <cstdint> // uint64_t, uint32_t 등 사용
 #include <functional> // 콜백 함수(std::function) 사용
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+#include "PacketRange.h"
+#include "IFileSplitterAndMerger.h" // Packet
 
 // 옵저버 패턴: 패킷 처리 결과를 알려주는 콜백 함수 타입 정의
 // (세션ID, 패킷번호, 상태코드)를 인자로 받음
 using UdpPacketCallback = std::function<void(uint64_t, uint64_t, int)>;
 
+// 콜백으로 전달되는 상태코드
+constexpr int UDP_PACKET_RECEIVED  = 1;  // 정상 수신
+constexpr int UDP_PACKET_CORRUPTED = -2; // 체크섬 불일치 -> 재전송(FILE_RESEND) 필요
+constexpr int UDP_PACKET_RECOVERED = 2;  // FEC 패리티로 복원됨 (재전송 불필요)
+constexpr int UDP_PACKET_LOCAL     = 3;  // 로컬에 이미 있던 청크로 채움 (CDC 중복 제거)
+constexpr int UDP_PACKET_THROTTLED = -3; // 메모리 예산 초과로 저장하지 않음 -> ACK 하지 않으므로 재전송으로 다시 받음
+
+// 배치 옵저버로 전달되는 진행 상황 묶음
+// 패킷마다 콜백을 부르지 않고, 일정 시간/개수마다 패킷 구간 단위로 한 번에 전달한다.
+struct UdpProgressBatch {
+    uint64_t sessionId;
+    std::vector<PacketRange> received;  // 정상 수신 (0 구간 표식 포함)
+    std::vector<PacketRange> recovered; // FEC 로 복원
+    std::vector<PacketRange> local;     // 로컬 청크로 채움
+    std::vector<PacketRange> corrupted; // 체크섬 불일치 -> 재전송 필요
+    uint64_t receivedCount;             // 지금까지 받은 청크 수
+    uint64_t totalPackets;              // 전체 청크 수
+};
+
+// 배치 옵저버 콜백 타입
+using UdpBatchCallback = std::function<void(const UdpProgressBatch&)>;
+
+// 배치를 한 줄 요약 문자열로 변환 (TCP 제어 채널 진행 알림용)
+// 형식: "<세션ID> <받은 수>/<전체> received=a-b,... recovered=... local=... corrupted=..."
+inline std::string FormatProgressBatch(const UdpProgressBatch& batch) {
+    std::string out = std::to_string(batch.sessionId) + " " +
+                      std::to_string(batch.receivedCount) + "/" + std::to_string(batch.totalPackets);
+    const std::pair<const char*, const std::vector<PacketRange>*> fields[] = {
+        {"received", &batch.received}, {"recovered", &batch.recovered},
+        {"local", &batch.local}, {"corrupted", &batch.corrupted},
+    };
+    for (const auto& field : fields) {
+        if (field.second->empty()) continue;
+        out += " ";
+        out += field.first;
+        out += "=";
+        out += FormatPacketRanges(*field.second);
+    }
+    return out;
+}
+
+// 이어받기(resume) 판단에 쓰는 송신 파일 식별 정보 (FILE_INFO 로 전달받음)
+struct UdpFileIdentity {
+    uint64_t fileSize;   // 원본 파일 크기 (바이트)
+    int64_t  mtime;      // 원본 파일 수정 시각 (나노초)
+    uint32_t chunkSize;  // 청크(패킷 payload) 크기
+};
+
 class IUDPModel {
 public:
     virtual ~IUDPModel() = default;
@@ -21,15 +75,90 @@ public:
      */
     virtual int InitializeSession(uint64_t sessionId, uint64_t totalPackets, const char* filename) = 0;
 
+    /**
+     * @brief 이어받기 가능한 전송 세션을 초기화합니다.
+     * 수신한 청크를 filename 에 바로 기록하고, 완료 비트맵을 옆의
+     * "<filename>.rcvmap" 사이드카 파일(mmap)에 주기적으로 저장합니다.
+     * 같은 식별 정보의 사이드카가 남아 있으면 그 상태에서 이어받습니다.
+     * @param sessionId 고유 세션 ID
+     * @param totalPackets 전체 패킷 개수
+     * @param filename 저장할 파일 이름
+     * @param identity 송신 파일 식별 정보
+     * @return 새로 시작하면 1, 이전 상태를 복원했으면 2, 실패 시 -1
+     */
+    virtual int InitializeResumableSession(uint64_t sessionId, uint64_t totalPackets,
+                                           const char* filename, const UdpFileIdentity& identity) = 0;
+
+    /**
+     * @brief 스트리밍 수신 세션을 초기화합니다. (파이프/소켓처럼 seek 할 수 없는 출력)
+     * 청크는 windowPackets 칸짜리 재정렬 창에만 담고, 앞에서부터 이어진 구간이
+     * 완성되는 즉시 sinkFd 로 순서대로 기록합니다. 창 밖의 청크는 버리므로
+     * (UDP_PACKET_THROTTLED) 송신 측에는 FILE_SEND ... WINDOW <windowPackets> 로 요청하고
+     * TakeWindowUpdate 가 알려주는 상한을 FILE_WINDOW 로 보내야 합니다.
+     * FEC / ExportPackets / StoreLocalChunk 는 지원하지 않습니다.
+     * @param sessionId 고유 세션 ID
+     * @param totalPackets 전체 패킷 개수
+     * @param sinkFd 출력 fd (소유하지 않음, non-blocking 이면 막힐 때 창에 남겨 둠)
+     * @param windowPackets 재정렬 창 칸 수
+     * @return 성공 시 1, 실패 시 -1
+     */
+    virtual int InitializeStreamingSession(uint64_t sessionId, uint64_t totalPackets,
+                                           int sinkFd, uint32_t windowPackets) = 0;
+
+    /**
+     * @brief 스트리밍 세션의 수신 창이 앞으로 움직였으면 새 상한을 꺼냅니다.
+     * 창의 1/4 이상 움직였거나 창 밖 패킷이 들어온 뒤(송신 측이 앞서 나감)에만 true 입니다.
+     * 싱크가 막혀 창이 멈추면 상한도 그대로여서 송신 측이 기다리게 됩니다.
+     * @param windowEnd 받을 수 있는 packet_index 상한 (FILE_WINDOW <windowEnd>)
+     * @return 알릴 것이 있으면 true
+     */
+    virtual bool TakeWindowUpdate(uint64_t& windowEnd) = 0;
+
+    /**
+     * @brief 스트리밍 세션에서 싱크가 막혀 남아 있던 구간을 다시 기록합니다.
+     * non-blocking 싱크를 쓸 때 싱크가 쓰기 가능해지면 호출합니다.
+     * @return 기록한 바이트 수, 싱크 오류면 -1
+     */
+    virtual int64_t FlushStream() = 0;
+
+    /**
+     * @brief 아직 받지 못한 패킷 구간 목록을 반환합니다.
+     * 이어받기 시 FILE_SEND ... RESUME 요청에 그대로 실어 보냅니다.
+     */
+    virtual std::vector<PacketRange> GetMissingRanges() = 0;
+
+    /**
+     * @brief [begin, end) 안에서 아직 받지 못한 패킷 구간 목록을 반환합니다.
+     * 전체를 훑지 않고 구간 길이만큼만 확인합니다. (스트리밍이면 창 뒤쪽도 빠진 것으로 나옴)
+     */
+    virtual std::vector<PacketRange> GetMissingRangesWithin(uint64_t begin, uint64_t end) = 0;
+
+    /**
+     * @brief 마지막 호출 이후 수신(중복 포함)한 패킷 구간을 꺼냅니다.
+     * 송신 측 재전송 타이머를 멈추도록 FILE_ACK 에 실어 보냅니다.
+     * 중복 패킷도 포함하므로 ACK 가 유실돼도 다음 재전송 때 다시 확인됩니다.
+     */
+    virtual std::vector<PacketRange> TakeAckRanges() = 0;
+
     /**
      * @brief UDP로 수신된 로우(Raw) 데이터를 처리합니다.
      * 내부에서 패킷 헤더를 분석하고 데이터를 버퍼에 저장한 뒤, 콜백을 호출합니다.
      * * @param rawData 수신된 바이너리 데이터 포인터
      * @param length 데이터 길이
-     * @return 처리 성공 시 1, 실패(잘못된 패킷 등) 시 -1
+     * @return 처리 성공 시 1, 실패(잘못된 패킷 등) 시 -1, 체크섬 불일치 시 -2
      */
     virtual int ProcessReceivedPacket(const unsigned char* rawData, int length) = 0;
 
+    /**
+     * @brief 로컬에 이미 있는 청크로 패킷 자리를 채웁니다. (CDC 매니페스트 전송)
+     * 수신 측이 FILE_HAVE 로 알려준 청크는 UDP 로 오지 않으므로 직접 채워야 합니다.
+     * @param packetIndex 매니페스트상의 청크 번호
+     * @param data 청크 데이터
+     * @param length 청크 길이
+     * @return 성공 시 1, 범위 밖이면 -1, 메모리 예산을 넘으면 UDP_PACKET_THROTTLED
+     */
+    virtual int StoreLocalChunk(uint64_t packetIndex, const unsigned char* data, uint32_t length) = 0;
+
     /**
      * @brief 데이터 전송 함수 (Sender 역할일 경우 사용)
      * 데이터를 패킷 단위로 쪼개서 전송합니다.
@@ -44,6 +173,55 @@ public:
      * @param callback 호출될 함수
      */
     virtual void SetStatusCallback(UdpPacketCallback callback) = 0;
+
+    /**
+     * @brief 진행 상황을 모아서 받을 배치 옵저버를 등록합니다.
+     * 패킷마다 호출되는 SetStatusCallback 대신, 수신 결과를 패킷 구간으로 묶어
+     * intervalMs 가 지나거나 packetThreshold 개가 쌓이면 한 번에 전달합니다.
+     * 세션이 완료되면 남은 내용을 바로 전달합니다.
+     * 콜백은 ProcessReceivedPacket 을 호출한 스레드에서 잠금 없이 호출됩니다.
+     * @param callback 호출될 함수 (빈 함수면 배치 옵저버 해제)
+     * @param intervalMs 최대 전달 간격 (밀리초)
+     * @param packetThreshold 이만큼 쌓이면 간격과 상관없이 전달 (0이면 개수 제한 없음)
+     */
+    virtual void SetBatchCallback(UdpBatchCallback callback, uint32_t intervalMs, uint64_t packetThreshold) = 0;
+
+    /**
+     * @brief 아직 전달하지 않은 배치를 지금 전달합니다. (쌓인 내용이 없으면 아무것도 하지 않음)
+     * 수신이 멈춘 동안에도 주기적으로 알림을 받으려면 타이머에서 호출합니다.
+     */
+    virtual void FlushNotifications() = 0;
+
+    /**
+     * @brief FEC 패리티 수신을 활성화합니다. (InitializeSession 이후 호출)
+     * 패리티 패킷은 packet_index = totalPackets + (그룹 * m + j) 로 들어옵니다.
+     * @param k 그룹당 데이터 청크 수
+     * @param m 그룹당 패리티 청크 수 (0이면 FEC 끔)
+     * @return 성공 시 1, 잘못된 파라미터면 -1
+     */
+    virtual int SetFecParams(uint32_t k, uint32_t m) = 0;
+
+    /**
+     * @brief 모든 패킷을 수신했는지 확인합니다.
+     * 스트리밍 세션은 싱크로 모두 기록했을 때 완료입니다.
+     * @return 전부 수신했으면 true
+     */
+    virtual bool IsSessionComplete() = 0;
+
+    /**
+     * @brief 완료된 세션의 청크들을 Packet 목록으로 내보냅니다. (디렉터리 전송)
+     * 결과는 FileSplitterAndMerger::MergeDirectory 에 그대로 넘길 수 있습니다.
+     * 0 청크는 데이터를 만들지 않고 0 구간 표식 Packet 으로 내보냅니다.
+     * @param out 내보낸 Packet 목록 (출력 매개변수)
+     * @return 성공 시 1, 세션이 아직 완료되지 않았으면 -1
+     */
+    virtual int ExportPackets(std::vector<Packet>& out) = 0;
+
+    /**
+     * @brief 지금까지 순서대로 이어진 구간으로 누적 계산한 파일 전체 CRC32C
+     * 세션이 완료된 뒤에는 송신 측이 FILE_SEND_DONE 으로 알려준 값과 비교합니다.
+     */
+    virtual uint32_t GetFileDigest() = 0;
 };
 
 #endif // I_UDP_MODEL_H
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "MultiSourceScheduler.h"
+#include <algorithm>
+
+MultiSourceScheduler::MultiSourceScheduler(IUDPModel& model, uint64_t totalPackets, std::size_t sourceCount)
+    : m_model(model),
+      m_totalPackets(totalPackets),
+      m_nextUnassigned(0),
+      m_sources(sourceCount) {
+}
+
+int MultiSourceScheduler::NextRange(std::size_t source, Clock::time_point now, PacketRange& out) {
+    if (source >= m_sources.size()) {
+        return -1;
+    }
+
+    SourceState& state = m_sources[source];
+    if (!state.active || state.busy) {
+        return -1;
+    }
+
+    // 1. 아직 아무도 맡지 않은 구간, 2. 없으면 늦게 끝날 서버의 몫을 가져온다
+    if (!TakeUnassigned(BatchSize(state), out) && !StealFrom(source, now, out)) {
+        return -1;
+    }
+
+    state.busy = true;
+    state.range = out;
+    state.cursor = out.begin;
+    state.started = now;
+    return 1;
+}
+
+void MultiSourceScheduler::OnRangeDone(std::size_t source, Clock::time_point now) {
+    if (source >= m_sources.size() || !m_sources[source].busy) {
+        return;
+    }
+
+    SourceState& state = m_sources[source];
+    state.busy = false;
+
+    // 처리량 갱신 (구간을 뺏겼으면 줄어든 구간 기준)
+    double seconds = std::chrono::duration<double>(now - state.started).count();
+    uint64_t count = state.range.end - state.range.begin;
+    if (seconds > 0.0 && count > 0) {
+        double sample = count / seconds;
+        state.throughput = (state.throughput == 0.0)
+            ? sample
+            : THROUGHPUT_ALPHA * sample + (1.0 - THROUGHPUT_ALPHA) * state.throughput;
+    }
+
+    // 구간 안에서 빠진 패킷은 다시 나눠 준다
+    for (const auto& missing : MissingWithin(state)) {
+        m_retry.push_back(missing);
+    }
+    state.range = {0, 0};
+}
+
+void MultiSourceScheduler::RemoveSource(std::size_t source) {
+    if (source >= m_sources.size()) {
+        return;
+    }
+
+    SourceState& state = m_sources[source];
+    if (state.busy) {
+        for (const auto& missing : MissingWithin(state)) {
+            m_retry.push_back(missing);
+        }
+    }
+    state = SourceState{};
+    state.active = false;
+}
+
+double MultiSourceScheduler::GetThroughput(std::size_t source) const {
+    return source < m_sources.size() ? m_sources[source].throughput : 0.0;
+}
+
+std::vector<MultiSourceScheduler::CancelRequest> MultiSourceScheduler::TakeCancelledRanges() {
+    std::vector<CancelRequest> cancelled;
+    cancelled.swap(m_cancelled);
+    return cancelled;
+}
+
+bool MultiSourceScheduler::TakeUnassigned(uint64_t batch, PacketRange& out) {
+    // 재시도 구간 먼저 (앞에서부터 batch 만큼 잘라서)
+    while (!m_retry.empty()) {
+        PacketRange& front = m_retry.front();
+        if (front.begin >= front.end) {
+            m_retry.erase(m_retry.begin());
+            continue;
+        }
+        out.begin = front.begin;
+        out.end = std::min(front.end, front.begin + batch);
+        front.begin = out.end;
+        if (front.begin >= front.end) {
+            m_retry.erase(m_retry.begin());
+        }
+        return true;
+    }
+
+    if (m_nextUnassigned >= m_totalPackets) {
+        return false;
+    }
+
+    out.begin = m_nextUnassigned;
+    out.end = std::min(m_totalPackets, m_nextUnassigned + batch);
+    m_nextUnassigned = out.end;
+    return true;
+}
+
+bool MultiSourceScheduler::StealFrom(std::size_t thief, Clock::time_point now, PacketRange& out) {
+    // 남은 예상 시간이 가장 긴 서버를 고른다
+    std::size_t victim = m_sources.size();
+    uint64_t victimFirst = 0;
+    double victimSeconds = -1.0;
+
+    for (std::size_t i = 0; i < m_sources.size(); ++i) {
+        SourceState& state = m_sources[i];
+        if (i == thief || !state.busy) {
+            continue;
+        }
+
+        auto missing = MissingWithin(state);
+        if (missing.empty()) {
+            continue;
+        }
+
+        uint64_t first = missing.front().begin;
+        uint64_t remaining = state.range.end - first;
+        if (remaining < 2 * MIN_STEAL) {
+            continue;
+        }
+
+        // 처리량을 아직 모르면 지금까지 진행한 속도로 추정 (진행이 없으면 가장 느린 것으로 본다)
+        double throughput = state.throughput;
+        if (throughput == 0.0) {
+            double elapsed = std::chrono::duration<double>(now - state.started).count();
+            uint64_t done = first - state.range.begin;
+            throughput = (elapsed > 0.0 && done > 0) ? done / elapsed : 0.0;
+        }
+        double seconds = (throughput > 0.0) ? remaining / throughput : 1e30;
+
+        if (seconds > victimSeconds) {
+            victim = i;
+            victimFirst = first;
+            victimSeconds = seconds;
+        }
+    }
+
+    if (victim == m_sources.size()) {
+        return false;
+    }
+
+    // 두 서버 처리량 비율대로 남은 구간을 나눠, 뒷부분을 가져간다
+    SourceState& from = m_sources[victim];
+    double mine = m_sources[thief].throughput;
+    double theirs = from.throughput;
+    double share = (mine > 0.0 && theirs > 0.0) ? mine / (mine + theirs) : 0.5;
+
+    uint64_t remaining = from.range.end - victimFirst;
+    uint64_t stolen = std::clamp<uint64_t>(static_cast<uint64_t>(remaining * share), MIN_STEAL, remaining - MIN_STEAL);
+
+    out.begin = from.range.end - stolen;
+    out.end = from.range.end;
+    from.range.end = out.begin;
+
+    // 원래 서버 큐에 남은 몫은 취소를 보내 중복 전송을 줄인다
+    m_cancelled.push_back({victim, out});
+    return true;
+}
+
+uint64_t MultiSourceScheduler::BatchSize(const SourceState& state) const {
+    if (state.throughput == 0.0) {
+        return INITIAL_BATCH;
+    }
+    return std::clamp<uint64_t>(static_cast<uint64_t>(state.throughput * TARGET_REQUEST_SECONDS), MIN_BATCH, MAX_BATCH);
+}
+
+std::vector<PacketRange> MultiSourceScheduler::MissingWithin(SourceState& state) {
+    // 받은 패킷이 다시 빠지는 일은 없으므로 앞쪽의 연속으로 받은 부분은 건너뛴다
+    uint64_t begin = std::max(state.cursor, state.range.begin);
+    if (begin >= state.range.end) {
+        return {};
+    }
+
+    std::vector<PacketRange> result = m_model.GetMissingRangesWithin(begin, state.range.end);
+    state.cursor = result.empty() ? state.range.end : result.front().begin;
+    return result;
+}
@@ -0,0 +1,106 @@
+#ifndef MULTI_SOURCE_SCHEDULER_H
+#define MULTI_SOURCE_SCHEDULER_H
+
+#include "IUDPModel.h"
+#include "PacketRange.h"
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// 여러 서버에서 같은 파일의 서로 다른 청크 구간을 동시에 받아오는 수신 측 스케줄러
+//
+// - 모든 서버는 같은 크기로 파일을 나누므로 packet_index 가 전역 번호가 된다.
+//   그래서 어느 서버가 보낸 청크든 같은 UDPModel 세션에 그대로 들어간다.
+// - 서버마다 한 번에 하나의 구간(FILE_RANGE 요청)만 맡긴다.
+//   구간 크기는 그 서버의 측정된 처리량에 비례해서 정한다.
+// - 나눠 줄 구간이 떨어지면, 가장 늦게 끝날 것 같은 서버 구간의 남은 뒷부분을 가져와서
+//   느린 서버에 걸린 작업을 빠른 서버로 옮긴다.
+//   옮긴 구간은 TakeCancelledRanges 로 꺼내 원래 서버에 FILE_RANGE_CANCEL 로 알린다.
+class MultiSourceScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 다른 서버로 옮겨서 원래 서버에 취소를 보내야 하는 구간
+    struct CancelRequest {
+        std::size_t source;
+        PacketRange range;
+    };
+
+    /**
+     * @param model 청크가 모이는 수신 세션 (이미 초기화되어 있어야 함)
+     * @param totalPackets 전체 패킷 개수
+     * @param sourceCount 서버 개수
+     */
+    MultiSourceScheduler(IUDPModel& model, uint64_t totalPackets, std::size_t sourceCount);
+
+    /**
+     * @brief source 서버에 다음으로 요청할 구간을 정합니다.
+     * @param source 서버 번호
+     * @param now 현재 시각
+     * @param out 요청할 구간 (출력 매개변수)
+     * @return 구간이 있으면 1, 이미 맡은 구간이 있거나 더 받을 것이 없으면 -1
+     */
+    int NextRange(std::size_t source, Clock::time_point now, PacketRange& out);
+
+    /**
+     * @brief source 서버가 맡은 구간 전송을 끝냈음을 알립니다. (FILE_RANGE_DONE 수신)
+     * 처리량을 갱신하고, 구간 안에서 빠진 패킷은 다시 나눠 줄 목록에 넣습니다.
+     */
+    void OnRangeDone(std::size_t source, Clock::time_point now);
+
+    /**
+     * @brief source 서버를 더 이상 쓰지 않습니다. (연결 끊김 등)
+     * 맡고 있던 구간은 다른 서버에게 넘어갑니다.
+     */
+    void RemoveSource(std::size_t source);
+
+    /**
+     * @brief 서버별 측정 처리량 (패킷/초, 아직 측정 전이면 0)
+     */
+    double GetThroughput(std::size_t source) const;
+
+    /**
+     * @brief 다른 서버로 옮긴 구간 목록을 꺼냅니다. (꺼낸 뒤 비워짐)
+     * 원래 서버에 FILE_RANGE_CANCEL 로 보내서 아직 큐에 남은 패킷을 지우게 합니다.
+     * 취소가 닿기 전에 이미 나간 패킷은 두 서버에서 한 번씩 오고, 수신 측이 중복으로 처리합니다.
+     */
+    std::vector<CancelRequest> TakeCancelledRanges();
+
+private:
+    struct SourceState {
+        bool active = true;
+        bool busy = false;
+        PacketRange range{0, 0};       // 지금 맡은 구간
+        uint64_t cursor = 0;           // 구간 안에서 이 앞은 모두 받음 (다시 훑지 않음)
+        Clock::time_point started;     // 구간을 맡긴 시각
+        double throughput = 0.0;       // 패킷/초 (지수 이동 평균)
+    };
+
+    // 아직 아무에게도 맡기지 않은 구간을 batch 만큼 꺼낸다 (재시도 목록 먼저)
+    bool TakeUnassigned(uint64_t batch, PacketRange& out);
+    // 다른 서버 구간의 남은 뒷부분을 가져온다
+    bool StealFrom(std::size_t thief, Clock::time_point now, PacketRange& out);
+    // 서버 처리량에 맞춘 요청 크기
+    uint64_t BatchSize(const SourceState& state) const;
+    // 맡은 구간 안에서 아직 받지 못한 패킷 구간 목록 (cursor 부터 구간 길이만큼만 확인)
+    std::vector<PacketRange> MissingWithin(SourceState& state);
+
+    IUDPModel& m_model;
+    uint64_t m_totalPackets;
+    uint64_t m_nextUnassigned;
+    std::vector<PacketRange> m_retry;   // 다시 나눠 줄 구간 (손실, 빠진 서버 몫)
+    std::vector<SourceState> m_sources;
+    std::vector<CancelRequest> m_cancelled; // 아직 원래 서버에 알리지 않은 취소
+
+    // 요청 하나가 이 시간 정도 걸리도록 구간 크기를 정한다
+    static constexpr double TARGET_REQUEST_SECONDS = 0.25;
+    static constexpr uint64_t MIN_BATCH = 64;
+    static constexpr uint64_t MAX_BATCH = 8192;
+    static constexpr uint64_t INITIAL_BATCH = 256;
+    // 처리량 이동 평균 가중치
+    static constexpr double THROUGHPUT_ALPHA = 0.3;
+    // 남은 양이 이보다 적으면 가져오지 않는다 (중복 전송만 늘어남)
+    static constexpr uint64_t MIN_STEAL = 16;
+};
+
+#endif
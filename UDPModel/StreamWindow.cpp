@@ -0,0 +1,115 @@
+#include "StreamWindow.h"
+#include "ZeroRange.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <sys/uio.h> // writev
+
+StreamWindow::StreamWindow(int sinkFd, uint32_t windowPackets, uint64_t totalPackets)
+    : m_sinkFd(sinkFd), m_totalPackets(totalPackets), m_base(0), m_baseOffset(0),
+      m_slots(std::max<uint32_t>(windowPackets, 1)), m_budget(MEM_RECV_BUFFERS) {
+}
+
+bool StreamWindow::IsReceived(uint64_t index) const {
+    if (index < m_base) return true;
+    if (index >= WindowEnd()) return false;
+    return EntryOf(index).filled;
+}
+
+uint64_t StreamWindow::WindowEnd() const {
+    return std::min<uint64_t>(m_base + m_slots.size(), m_totalPackets);
+}
+
+std::vector<unsigned char>& StreamWindow::Slot(uint64_t index) {
+    return EntryOf(index).data;
+}
+
+void StreamWindow::Commit(uint64_t index, uint32_t zeroLength) {
+    Entry& entry = EntryOf(index);
+    entry.zeroLength = zeroLength;
+    entry.filled = true;
+    if (zeroLength > 0) {
+        entry.data.clear();
+    }
+    AccountSlot(entry);
+}
+
+void StreamWindow::AccountSlot(Entry& entry) {
+    // 칸 버퍼는 비워도 용량을 유지하므로, 용량이 늘어난 만큼만 더한다
+    if (entry.data.capacity() > entry.accounted) {
+        m_budget.Resize(m_budget.Bytes() + (entry.data.capacity() - entry.accounted));
+        entry.accounted = entry.data.capacity();
+    }
+}
+
+int64_t StreamWindow::Flush() {
+    int64_t written = 0;
+
+    while (m_base < m_totalPackets && EntryOf(m_base).filled) {
+        // 1. 연속으로 채워진 칸을 iovec 으로 모은다 (첫 칸은 이미 쓴 부분을 건너뜀)
+        //    0 칸은 공용 0 버퍼가 ZERO_BUFFER_BYTES 뿐이므로 그 크기씩 나눠 담는다
+        iovec iov[MAX_IOV];
+        bool entryEnd[MAX_IOV]; // 이 iovec 으로 칸 하나가 끝나는지
+        std::size_t count = 0;
+        for (uint64_t i = m_base; i < WindowEnd() && count < MAX_IOV; ++i) {
+            const Entry& entry = EntryOf(i);
+            if (!entry.filled) break;
+
+            std::size_t offset = (i == m_base) ? m_baseOffset : 0;
+            if (entry.zeroLength == 0) {
+                iov[count] = {const_cast<unsigned char*>(entry.data.data()) + offset, entry.data.size() - offset};
+                entryEnd[count++] = true;
+                continue;
+            }
+
+            while (offset < entry.zeroLength && count < MAX_IOV) {
+                std::size_t length = std::min<std::size_t>(entry.zeroLength - offset, ZERO_BUFFER_BYTES);
+                offset += length;
+                iov[count] = {const_cast<unsigned char*>(ZeroBuffer()), length};
+                entryEnd[count++] = (offset == entry.zeroLength);
+            }
+        }
+
+        // 2. 기록 (싱크가 막히면 남은 것은 다음 Flush 로)
+        ssize_t n = writev(m_sinkFd, iov, static_cast<int>(count));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+
+        // 3. 기록된 만큼 다이제스트에 누적하고, 다 쓴 칸은 비워서 창을 앞으로 민다
+        std::size_t remain = static_cast<std::size_t>(n);
+        for (std::size_t k = 0; k < count && remain > 0; ++k) {
+            std::size_t used = std::min(remain, iov[k].iov_len);
+            m_digest.Update(iov[k].iov_base, used);
+            remain -= used;
+
+            if (used < iov[k].iov_len || !entryEnd[k]) {
+                m_baseOffset += used;
+                continue;
+            }
+            EntryOf(m_base).filled = false;
+            EntryOf(m_base).data.clear();
+            ++m_base;
+            m_baseOffset = 0;
+        }
+        written += n;
+
+        if (static_cast<std::size_t>(n) == 0) break;
+    }
+    return written;
+}
+
+std::vector<PacketRange> StreamWindow::MissingRanges() const {
+    std::vector<PacketRange> ranges;
+    uint64_t end = WindowEnd();
+    for (uint64_t i = m_base; i < end; ++i) {
+        if (EntryOf(i).filled) continue;
+
+        uint64_t begin = i;
+        while (i < end && !EntryOf(i).filled) ++i;
+        ranges.push_back({begin, i});
+    }
+    return ranges;
+}
@@ -0,0 +1,93 @@
+#ifndef STREAM_WINDOW_H
+#define STREAM_WINDOW_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Crc32c.h"
+#include "MemoryBudget.h"
+#include "PacketRange.h"
+
+// ================================================================
+//  스트리밍 수신용 고정 크기 재정렬 창
+//
+//  - packet_index % 창 크기 번째 칸에 청크를 담고, 앞에서부터 연속으로 채워진
+//    구간이 생기는 즉시 싱크(파이프/소켓 등 seek 할 수 없는 fd)로 순서대로 흘려 보낸다.
+//  - 받을 수 있는 구간은 [Base, WindowEnd) 뿐이다. 그 밖의 청크는 저장하지 않으므로
+//    파일 크기와 상관없이 메모리는 창 크기 x 청크 크기로 고정된다.
+//  - 싱크가 막히면(EAGAIN) 남은 구간은 창에 그대로 두고 다음 Flush 에서 이어 쓴다.
+//    이때 WindowEnd 가 앞으로 가지 않는 것이 송신 측에 전달되는 압력 신호가 된다.
+// ================================================================
+
+class StreamWindow {
+public:
+    /**
+     * @param sinkFd         순서대로 기록할 fd (소유하지 않음, 닫지 않음)
+     * @param windowPackets  칸 수 (동시에 들고 있을 수 있는 최대 청크 수)
+     * @param totalPackets   전송 전체 청크 수
+     */
+    StreamWindow(int sinkFd, uint32_t windowPackets, uint64_t totalPackets);
+
+    StreamWindow(const StreamWindow&) = delete;
+    StreamWindow& operator=(const StreamWindow&) = delete;
+
+    // 창 안에 있어 지금 받을 수 있는 번호인지
+    bool Accepts(uint64_t index) const { return index >= m_base && index < WindowEnd(); }
+
+    // 이미 받은 번호인지 (싱크로 보낸 것 포함)
+    bool IsReceived(uint64_t index) const;
+
+    // index 칸의 버퍼 (내용을 채운 뒤 Commit 호출, Accepts(index) 일 때만)
+    std::vector<unsigned char>& Slot(uint64_t index);
+
+    // index 칸을 채워진 것으로 표시 (zeroLength > 0 이면 버퍼 대신 0 바이트 zeroLength 개)
+    void Commit(uint64_t index, uint32_t zeroLength = 0);
+
+    /**
+     * @brief 앞에서부터 연속으로 채워진 칸을 싱크로 기록한다. (writev 한 번에 여러 칸)
+     * @return 기록한 바이트 수, 싱크 오류면 -1 (EAGAIN 은 오류가 아님)
+     */
+    int64_t Flush();
+
+    // 다음에 싱크로 보낼 번호 (이 앞은 모두 기록 완료)
+    uint64_t Base() const { return m_base; }
+
+    // 받을 수 있는 번호 상한 (이 값 미만)
+    uint64_t WindowEnd() const;
+
+    // [Base, WindowEnd) 중 아직 비어 있는 구간
+    std::vector<PacketRange> MissingRanges() const;
+
+    // 싱크로 기록한 바이트 전체의 CRC32C (송신 측 FILE_SEND_DONE 다이제스트와 비교)
+    uint32_t Digest() const { return m_digest.Value(); }
+
+    // 모든 청크를 싱크로 보냈는지
+    bool IsDrained() const { return m_base == m_totalPackets; }
+
+private:
+    struct Entry {
+        std::vector<unsigned char> data;
+        uint32_t zeroLength = 0;
+        bool filled = false;
+        std::size_t accounted = 0; // 메모리 예산에 올린 data 용량
+    };
+
+    Entry& EntryOf(uint64_t index) { return m_slots[index % m_slots.size()]; }
+    const Entry& EntryOf(uint64_t index) const { return m_slots[index % m_slots.size()]; }
+
+    // 칸 버퍼 용량이 늘어난 만큼 메모리 예산에 반영 (칸은 재사용하므로 곧 변하지 않는다)
+    void AccountSlot(Entry& entry);
+
+    // 한 번의 writev 에 담는 최대 칸 수
+    static constexpr std::size_t MAX_IOV = 64;
+
+    int m_sinkFd;
+    uint64_t m_totalPackets;
+    uint64_t m_base;        // 다음에 싱크로 보낼 번호
+    uint64_t m_baseOffset;  // m_base 칸에서 이미 기록한 바이트 수 (싱크가 중간에 막힌 경우)
+    std::vector<Entry> m_slots;
+    Crc32cDigest m_digest;
+    MemoryReservation m_budget;
+};
+
+#endif // STREAM_WINDOW_H
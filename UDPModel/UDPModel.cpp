@@ -1,61 +1,533 @@
 #include "UDPModel.h"
+#include "Trace.h"
 #include <iostream>
 #include <cstring> // memcpy 등
+#include <algorithm> // std::min
 
-UDPModel::UDPModel() : m_sessionId(0), m_totalPackets(0) {
+#include <fcntl.h>    // open
+#include <unistd.h>   // pwrite, pread, fdatasync, ftruncate, close, unlink
+#include <sys/mman.h> // mmap, msync, munmap
+#include <sys/stat.h> // fstat
+
+namespace {
+
+// 이어받기 사이드카 파일 헤더 (뒤에 완료 비트맵이 붙는다)
+struct ResumeMapHeader {
+    char     magic[8];      // RESUME_MAGIC
+    uint64_t fileSize;
+    int64_t  mtime;
+    uint32_t chunkSize;
+    uint32_t reserved;
+    uint64_t totalPackets;
+    uint64_t digestNext;    // 비트맵과 함께 저장한 파일 다이제스트 진행 위치
+    uint64_t digestBytes;
+    uint32_t digestCrc;
+    uint32_t reserved2;
+};
+
+constexpr char RESUME_MAGIC[8] = {'U', 'T', 'R', 'E', 'S', 'U', 'M', '1'};
+constexpr const char* RESUME_SUFFIX = ".rcvmap";
+
+// 구간 목록을 정렬하고 겹치거나 맞닿은 구간을 합친다
+void NormalizeRanges(std::vector<PacketRange>& ranges) {
+    if (ranges.size() < 2) return;
+
+    std::sort(ranges.begin(), ranges.end(),
+              [](const PacketRange& a, const PacketRange& b) { return a.begin < b.begin; });
+
+    std::size_t out = 0;
+    for (std::size_t i = 1; i < ranges.size(); ++i) {
+        if (ranges[i].begin <= ranges[out].end) {
+            ranges[out].end = std::max(ranges[out].end, ranges[i].end);
+        } else {
+            ranges[++out] = ranges[i];
+        }
+    }
+    ranges.resize(out + 1);
+}
+
+} // namespace
+
+UDPModel::UDPModel() : m_sessionId(0), m_totalPackets(0), m_receivedCount(0), m_bufferBudget(MEM_RECV_BUFFERS),
+    m_digestNext(0), m_fecK(0), m_fecM(0),
+    m_resumable(false), m_identity{}, m_outFd(-1), m_mapFd(-1), m_map(nullptr), m_mapSize(0),
+    m_reportedWindowEnd(0), m_windowUpdateDue(false),
+    m_batchInterval(0), m_batchThreshold(0), m_batch{}, m_batchEvents(0) {
     // 생성자 초기화
 }
 
 UDPModel::~UDPModel() {
-    // 소멸자 (필요 시 자원 해제)
+    // 이어받기 중이면 지금까지 받은 상태를 남겨 둔다
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CloseResumeLocked(false);
 }
 
 int UDPModel::InitializeSession(uint64_t sessionId, uint64_t totalPackets, const char* filename) {
     std::lock_guard<std::mutex> lock(m_mutex); // 스레드 안전하게 잠금
 
+    ResetSessionLocked(sessionId, totalPackets, filename);
+
+    std::cout << "[Model] Session Initialized. ID: " << m_sessionId << std::endl;
+    return 1;
+}
+
+int UDPModel::InitializeResumableSession(uint64_t sessionId, uint64_t totalPackets,
+                                         const char* filename, const UdpFileIdentity& identity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ResetSessionLocked(sessionId, totalPackets, filename);
+
+    // 1. 식별 정보와 패킷 개수가 맞는지 확인
+    if (identity.chunkSize == 0 ||
+        (identity.fileSize + identity.chunkSize - 1) / identity.chunkSize != totalPackets) {
+        return -1;
+    }
+
+    // 2. 출력 파일 열기 (전체 크기로 잡아 두고 청크 위치에 바로 기록)
+    m_outFd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (m_outFd < 0) {
+        CloseResumeLocked(false);
+        return -1;
+    }
+
+    // 3. 사이드카 비트맵 열기
+    std::string mapPath = m_oUDPutFilename + RESUME_SUFFIX;
+    m_mapFd = open(mapPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_mapFd < 0) {
+        CloseResumeLocked(false);
+        return -1;
+    }
+
+    m_mapSize = sizeof(ResumeMapHeader) + (totalPackets + 7) / 8;
+
+    struct stat st{};
+    bool sizeMatches = fstat(m_mapFd, &st) == 0 && static_cast<std::size_t>(st.st_size) == m_mapSize;
+    if (!sizeMatches && (ftruncate(m_mapFd, 0) < 0 || ftruncate(m_mapFd, static_cast<off_t>(m_mapSize)) < 0)) {
+        CloseResumeLocked(false);
+        return -1;
+    }
+
+    void* map = mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_mapFd, 0);
+    if (map == MAP_FAILED) {
+        CloseResumeLocked(false);
+        return -1;
+    }
+    m_map = static_cast<unsigned char*>(map);
+    m_resumable = true;
+    m_identity = identity;
+
+    // 4. 같은 파일의 이전 상태면 복원, 아니면 새로 기록
+    auto* header = reinterpret_cast<ResumeMapHeader*>(m_map);
+    bool restored = sizeMatches &&
+                    std::memcmp(header->magic, RESUME_MAGIC, sizeof(RESUME_MAGIC)) == 0 &&
+                    header->fileSize == identity.fileSize &&
+                    header->mtime == identity.mtime &&
+                    header->chunkSize == identity.chunkSize &&
+                    header->totalPackets == totalPackets;
+
+    if (restored) {
+        const unsigned char* bits = m_map + sizeof(ResumeMapHeader);
+        for (uint64_t i = 0; i < totalPackets; ++i) {
+            if (bits[i / 8] & (1u << (i % 8))) {
+                m_receivedStatus[i] = true;
+                ++m_receivedCount;
+            }
+        }
+        m_digestNext = header->digestNext;
+        m_fileDigest.Restore(header->digestCrc, header->digestBytes);
+    } else {
+        // 이전 내용이 남아 있으면 0 청크(구멍) 자리에 그대로 보이므로 비운다
+        ftruncate(m_outFd, 0);
+
+        std::memset(m_map, 0, m_mapSize);
+        std::memcpy(header->magic, RESUME_MAGIC, sizeof(RESUME_MAGIC));
+        header->fileSize = identity.fileSize;
+        header->mtime = identity.mtime;
+        header->chunkSize = identity.chunkSize;
+        header->totalPackets = totalPackets;
+        msync(m_map, m_mapSize, MS_SYNC);
+    }
+
+    if (ftruncate(m_outFd, static_cast<off_t>(identity.fileSize)) < 0) {
+        CloseResumeLocked(false);
+        return -1;
+    }
+
+    std::cout << "[Model] Resumable Session " << (restored ? "Restored" : "Initialized")
+              << ". ID: " << m_sessionId << ", have " << m_receivedCount << "/" << totalPackets << std::endl;
+    return restored ? 2 : 1;
+}
+
+int UDPModel::InitializeStreamingSession(uint64_t sessionId, uint64_t totalPackets,
+                                         int sinkFd, uint32_t windowPackets) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 패킷 수만큼 잡는 버퍼는 만들지 않는다 (창만 사용)
+    ResetSessionLocked(sessionId, 0, "");
+    if (sinkFd < 0 || windowPackets == 0) {
+        return -1;
+    }
+
+    m_totalPackets = totalPackets;
+    m_stream = std::make_unique<StreamWindow>(sinkFd, windowPackets, totalPackets);
+    m_reportedWindowEnd = m_stream->WindowEnd();
+
+    std::cout << "[Model] Streaming Session Initialized. ID: " << m_sessionId
+              << ", window " << windowPackets << std::endl;
+    return 1;
+}
+
+void UDPModel::ResetSessionLocked(uint64_t sessionId, uint64_t totalPackets, const char* filename) {
+    CloseResumeLocked(false);
+    m_stream.reset();
+    m_reportedWindowEnd = 0;
+    m_windowUpdateDue = false;
+
     m_sessionId = sessionId;
     m_totalPackets = totalPackets;
     m_oUDPutFilename = filename;
 
     // 버퍼 크기 잡기 (예시)
-    m_packetBuffer.resize(totalPackets);
-    m_receivedStatus.resize(totalPackets, false);
+    m_packetBuffer.assign(totalPackets, {});
+    m_receivedStatus.assign(totalPackets, false);
+    m_zeroLength.assign(totalPackets, 0);
+    m_receivedCount = 0;
+    m_ackPending.clear();
+    std::vector<unsigned char>().swap(m_chunkScratch);
+    m_bufferBudget.Release();
 
-    std::cout << "[Model] Session Initialized. ID: " << m_sessionId << std::endl;
-    return 1;
+    m_fileDigest.Reset();
+    m_digestNext = 0;
+
+    // FEC 는 세션마다 SetFecParams 로 다시 켠다
+    m_fecK = 0;
+    m_fecM = 0;
+    m_parityBuffer.clear();
+    m_parityReceived.clear();
+
+    // 이전 세션에서 전달하지 못한 배치는 버린다
+    m_batch = UdpProgressBatch{};
+    m_batchEvents = 0;
 }
 
 int UDPModel::ProcessReceivedPacket(const unsigned char* rawData, int length) {
-    if (length < sizeof(UdpPacketHeader)) {
+    if (length < 0 || static_cast<std::size_t>(length) < UDP_HEADER_BYTES) {
         return -1; // 헤더보다 작으면 에러
     }
 
-    // 1. 헤더 파싱
-    const UdpPacketHeader* header = reinterpret_cast<const UdpPacketHeader*>(rawData);
+    // 1. 헤더 파싱 (big-endian 와이어 -> 호스트 값, 정렬되지 않은 버퍼도 안전)
+    UdpPacketHeader header;
+    DecodeUdpPacketHeader(rawData, header);
+
+    // 모르는 버전이거나 payload 위치가 헤더 안/데이터그램 밖을 가리키면 버린다
+    if (header.version != UDP_HEADER_VERSION ||
+        header.payload_offset < UDP_HEADER_BYTES || header.payload_offset > length) {
+        return -1;
+    }
+
+    TRACE_SCOPE("ProcessReceivedPacket", header.packet_index);
 
     // 2. 세션 확인
-    if (header->session_id != m_sessionId) {
+    if (header.session_id != m_sessionId) {
         return -1; // 내 세션 패킷이 아닐
     }
 
-    // 3. 데이터 저장 (Critical Section)
+    // 길이 필드가 실제 수신 바이트보다 크면 잘린 패킷
+    const unsigned char* payload = rawData + header.payload_offset;
+    if (header.data_length > static_cast<uint32_t>(length - header.payload_offset)) {
+        return -1;
+    }
+
+    // 3. 체크섬 검증: 깨진 패킷은 버리고 재전송 경로로 넘긴다
+    //    v1 송신 측은 항상 체크섬을 붙이므로 플래그가 꺼져 있으면 그 비트가 깨진 것으로 본다
+    //    (플래그도 보호 대상 헤더 안에 있으므로 꺼진 플래그를 믿고 검증을 건너뛰면 안 됨)
+    if (!(header.flags & UDP_FLAG_CHECKSUM) ||
+        ComputeUdpPacketChecksum(rawData, Crc32c(payload, header.data_length)) != header.checksum) {
+        if (m_callback && header.packet_index < m_totalPackets) {
+            m_callback(header.session_id, header.packet_index, UDP_PACKET_CORRUPTED);
+        }
+
+        UdpProgressBatch batch;
+        bool batchDue = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (header.packet_index < m_totalPackets) {
+                RecordEventLocked(header.packet_index, 1, UDP_PACKET_CORRUPTED);
+            }
+            batchDue = TakeBatchLocked(batch, false);
+        }
+        if (batchDue) {
+            m_batchCallback(batch);
+        }
+        return UDP_PACKET_CORRUPTED;
+    }
+
+    // 4. 데이터 저장 (Critical Section)
+    std::vector<uint64_t> recovered; // FEC 로 복원된 청크들
+    uint64_t zeroCount = 0;          // 0 구간 표식이 덮은 청크 수
+    bool corrupted = false;
+    UdpProgressBatch batch;          // 배치 옵저버로 전달할 묶음
+    bool batchDue = false;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         
-        // 인덱스 범위 체크
-        if (header->packet_index >= m_totalPackets) return -1;
+        uint64_t index = header.packet_index;
+        bool wasComplete = m_totalPackets > 0 && m_receivedCount == m_totalPackets;
+
+        if (m_stream) {
+            // 스트리밍: 재정렬 창에 담고 이어진 구간은 바로 싱크로
+            int stored = StoreStreamLocked(header, payload, zeroCount, corrupted);
+            if (stored < 0 && stored != UDP_PACKET_CORRUPTED) {
+                return stored;
+            }
+        }
+        else if (index < m_totalPackets && (header.flags & PACKET_FLAG_ZERO)) {
+            // 0 구간 표식: 데이터 없이 구간 전체를 받은 것으로 처리 (출력 파일에는 구멍으로 남는다)
+            ZeroRange range{};
+            if (!DecodeZeroRangeLocked(payload, header.data_length, range)) {
+                corrupted = true;
+            } else {
+                zeroCount = std::min<uint64_t>(range.count, m_totalPackets - index);
+                for (uint64_t k = 0; k < zeroCount; ++k) {
+                    uint64_t i = index + k;
+                    if (m_receivedStatus[i]) {
+                        m_ackPending.push_back(i);
+                        continue;
+                    }
 
-        // 데이터 복사
-        const unsigned char* payload = rawData + sizeof(UdpPacketHeader);
-        m_packetBuffer[header->packet_index].assign(payload, payload + header->data_length);
-        m_receivedStatus[header->packet_index] = true;
+                    m_packetBuffer[i].clear();
+                    m_zeroLength[i] = ZeroRangeChunkLength(range, static_cast<uint32_t>(k));
+                    MarkReceivedLocked(i);
+
+                    if (m_fecM > 0) {
+                        AppendRecovered(recovered, TryRecoverStripeLocked(FecParityOf(i, m_fecK, m_fecM)));
+                    }
+                }
+            }
+        }
+        else if (index < m_totalPackets && m_receivedStatus[index]) {
+            // 이미 받은 청크 (중복/재전송): 버퍼는 건드리지 않고 ACK 만 다시
+            // (풀다가 실패하면 멀쩡한 청크를 지우게 되므로 payload 를 보지 않는다)
+            m_ackPending.push_back(index);
+        }
+        else if (index < m_totalPackets) {
+            // 압축 청크가 주장하는 원본 길이는 예산을 잡기 전에 검사한다 (비정상 길이는 깨진 패킷)
+            uint32_t chunkBytes = header.data_length;
+            if ((header.flags & PACKET_FLAG_COMPRESSED) &&
+                (!LzReadRawLength(payload, header.data_length, chunkBytes) || chunkBytes > MAX_RAW_CHUNK_BYTES)) {
+                corrupted = true;
+            }
+            // 메모리 예산: 예약하고, 모자라면 저장하지 않고 버린다
+            else if (!m_bufferBudget.TryGrow(chunkBytes)) {
+                return UDP_PACKET_THROTTLED;
+            }
+            else {
+                // 데이터 복사 (압축된 청크는 버퍼에 바로 풀어 쓴다)
+                if (header.flags & PACKET_FLAG_COMPRESSED) {
+                    corrupted = !DecompressIntoLocked(m_packetBuffer[index], payload, header.data_length);
+                } else {
+                    m_packetBuffer[index].assign(payload, payload + header.data_length);
+                }
+
+                if (corrupted) {
+                    m_bufferBudget.Resize(m_bufferBudget.Bytes() - chunkBytes);
+                } else {
+                    m_zeroLength[index] = 0;
+                    if (!MarkReceivedLocked(index)) {
+                        return -1; // 출력 파일 기록 실패 (받지 않은 것으로 남아 다시 요청된다)
+                    }
+
+                    if (m_fecM > 0) {
+                        AppendRecovered(recovered, TryRecoverStripeLocked(FecParityOf(index, m_fecK, m_fecM)));
+                    }
+                }
+            }
+        }
+        else if (index - m_totalPackets < m_parityBuffer.size()) {
+            // FEC 패리티 패킷: 데이터 청크 뒤쪽 인덱스를 사용
+            uint64_t parityIndex = index - m_totalPackets;
+            if (header.data_length < FEC_PARITY_LEN_BYTES) return -1;
+            if (!m_parityReceived[parityIndex] && !m_bufferBudget.TryGrow(header.data_length)) {
+                return UDP_PACKET_THROTTLED;
+            }
+
+            m_parityBuffer[parityIndex].assign(payload, payload + header.data_length);
+            m_parityReceived[parityIndex] = true;
+            AppendRecovered(recovered, TryRecoverStripeLocked(parityIndex));
+        }
+        else {
+            return -1; // 인덱스 범위 밖
+        }
+
+        AdvanceDigestLocked();
+
+        // 이어받기 모드에서 모두 받았으면 사이드카 정리
+        if (m_resumable && m_receivedCount == m_totalPackets) {
+            CloseResumeLocked(true);
+        }
+
+        // 배치 옵저버: 패킷마다 알리지 않고 구간으로 쌓아 두었다가 한 번에 전달
+        if (corrupted) {
+            RecordEventLocked(index, 1, UDP_PACKET_CORRUPTED);
+        } else if (zeroCount > 0) {
+            RecordEventLocked(index, zeroCount, UDP_PACKET_RECEIVED);
+        } else if (index < m_totalPackets) {
+            RecordEventLocked(index, 1, UDP_PACKET_RECEIVED);
+        }
+        for (uint64_t i : recovered) {
+            RecordEventLocked(i, 1, UDP_PACKET_RECOVERED);
+        }
+        // 이 패킷으로 세션이 완료됐으면 간격을 기다리지 않고 바로 전달
+        batchDue = TakeBatchLocked(batch, !wasComplete && m_receivedCount == m_totalPackets);
     }
 
-    // 4. 옵저버 패턴: 외부로 알림 (TCP 핸들러 등이 받음)
+    if (batchDue) {
+        m_batchCallback(batch);
+    }
+
+    // 체크섬은 맞았지만 풀 수 없는 압축 데이터 -> 재전송 경로로
+    if (corrupted) {
+        if (m_callback) {
+            m_callback(header.session_id, header.packet_index, UDP_PACKET_CORRUPTED);
+        }
+        return UDP_PACKET_CORRUPTED;
+    }
+
+    // 5. 옵저버 패턴: 외부로 알림 (TCP 핸들러 등이 받음)
     if (m_callback) {
-        m_callback(header->session_id, header->packet_index, 1);
+        if (zeroCount > 0) {
+            for (uint64_t k = 0; k < zeroCount; ++k) {
+                m_callback(header.session_id, header.packet_index + k, UDP_PACKET_RECEIVED);
+            }
+        }
+        else if (header.packet_index < m_totalPackets) {
+            m_callback(header.session_id, header.packet_index, UDP_PACKET_RECEIVED);
+        }
+        for (uint64_t index : recovered) {
+            m_callback(header.session_id, index, UDP_PACKET_RECOVERED);
+        }
+    }
+
+    return 1;
+}
+
+int UDPModel::StoreStreamLocked(const UdpPacketHeader& header, const unsigned char* payload,
+                                uint64_t& zeroCount, bool& corrupted) {
+    uint64_t index = header.packet_index;
+    if (index >= m_totalPackets) {
+        return -1; // 패리티 등 범위 밖
+    }
+
+    // 1. 이미 받은 청크 (싱크로 보낸 것 포함): ACK 만 다시
+    if (m_stream->IsReceived(index)) {
+        m_ackPending.push_back(index);
+        return 1;
+    }
+
+    // 2. 창 밖: 저장하지 않고 버린다 (ACK 하지 않음 -> 창이 열린 뒤 재전송)
+    if (!m_stream->Accepts(index)) {
+        m_windowUpdateDue = true;
+        return UDP_PACKET_THROTTLED;
+    }
+
+    // 3. 칸에 저장 (0 구간 표식은 창 끝까지만)
+    if (header.flags & PACKET_FLAG_ZERO) {
+        ZeroRange range{};
+        if (!DecodeZeroRangeLocked(payload, header.data_length, range)) {
+            corrupted = true;
+            return UDP_PACKET_CORRUPTED;
+        }
+        zeroCount = std::min<uint64_t>(range.count, m_stream->WindowEnd() - index);
+        for (uint64_t k = 0; k < zeroCount; ++k) {
+            uint64_t i = index + k;
+            m_ackPending.push_back(i);
+            if (m_stream->IsReceived(i)) continue;
+
+            m_stream->Commit(i, ZeroRangeChunkLength(range, static_cast<uint32_t>(k)));
+            ++m_receivedCount;
+        }
+    } else {
+        auto& chunk = m_stream->Slot(index);
+        if (header.flags & PACKET_FLAG_COMPRESSED) {
+            corrupted = !DecompressIntoLocked(chunk, payload, header.data_length);
+        } else {
+            chunk.assign(payload, payload + header.data_length);
+        }
+        if (corrupted) {
+            return UDP_PACKET_CORRUPTED;
+        }
+
+        m_stream->Commit(index);
+        m_ackPending.push_back(index);
+        ++m_receivedCount;
+    }
+
+    // 4. 앞에서부터 이어진 구간은 바로 싱크로
+    return m_stream->Flush() < 0 ? -1 : 1;
+}
+
+bool UDPModel::TakeWindowUpdate(uint64_t& windowEnd) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_stream) return false;
+
+    // 창이 1/4 이상 움직였을 때만 알린다 (패킷마다 FILE_WINDOW 를 보내지 않도록)
+    uint64_t end = m_stream->WindowEnd();
+    uint64_t step = std::max<uint64_t>((end - m_stream->Base()) / 4, 1);
+    if (!m_windowUpdateDue && end < m_reportedWindowEnd + step && end != m_totalPackets) {
+        return false;
+    }
+    if (!m_windowUpdateDue && end == m_reportedWindowEnd) {
+        return false;
+    }
+
+    m_windowUpdateDue = false;
+    m_reportedWindowEnd = end;
+    windowEnd = end;
+    return true;
+}
+
+int64_t UDPModel::FlushStream() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stream ? m_stream->Flush() : 0;
+}
+
+int UDPModel::StoreLocalChunk(uint64_t packetIndex, const unsigned char* data, uint32_t length) {
+    std::vector<uint64_t> recovered;
+    UdpProgressBatch batch;
+    bool batchDue = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stream || packetIndex >= m_totalPackets) return -1;
+        if (m_receivedStatus[packetIndex]) return 1;
+        if (!m_bufferBudget.TryGrow(length)) return UDP_PACKET_THROTTLED;
+
+        m_packetBuffer[packetIndex].assign(data, data + length);
+        m_zeroLength[packetIndex] = 0;
+        if (!MarkReceivedLocked(packetIndex)) return -1;
+
+        if (m_fecM > 0) {
+            AppendRecovered(recovered, TryRecoverStripeLocked(FecParityOf(packetIndex, m_fecK, m_fecM)));
+        }
+        AdvanceDigestLocked();
+
+        RecordEventLocked(packetIndex, 1, UDP_PACKET_LOCAL);
+        for (uint64_t i : recovered) {
+            RecordEventLocked(i, 1, UDP_PACKET_RECOVERED);
+        }
+        batchDue = TakeBatchLocked(batch, m_receivedCount == m_totalPackets);
+    }
+
+    if (batchDue) {
+        m_batchCallback(batch);
     }
 
+    if (m_callback) {
+        m_callback(m_sessionId, packetIndex, UDP_PACKET_LOCAL);
+        for (uint64_t index : recovered) {
+            m_callback(m_sessionId, index, UDP_PACKET_RECOVERED);
+        }
+    }
     return 1;
 }
 
@@ -67,4 +539,422 @@ int UDPModel::SendData(const unsigned char* data, int length) {
 
 void UDPModel::SetStatusCallback(UdpPacketCallback callback) {
     m_callback = callback;
+}
+
+void UDPModel::SetBatchCallback(UdpBatchCallback callback, uint32_t intervalMs, uint64_t packetThreshold) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_batchCallback = std::move(callback);
+    m_batchInterval = std::chrono::milliseconds(intervalMs);
+    m_batchThreshold = packetThreshold;
+    m_batch = UdpProgressBatch{};
+    m_batchEvents = 0;
+}
+
+void UDPModel::FlushNotifications() {
+    UdpProgressBatch batch;
+    bool batchDue = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        batchDue = TakeBatchLocked(batch, true);
+    }
+
+    if (batchDue) {
+        m_batchCallback(batch);
+    }
+}
+
+void UDPModel::RecordEventLocked(uint64_t first, uint64_t count, int status) {
+    if (!m_batchCallback || count == 0) return;
+
+    std::vector<PacketRange>* ranges = nullptr;
+    switch (status) {
+    case UDP_PACKET_RECEIVED:  ranges = &m_batch.received; break;
+    case UDP_PACKET_RECOVERED: ranges = &m_batch.recovered; break;
+    case UDP_PACKET_LOCAL:     ranges = &m_batch.local; break;
+    case UDP_PACKET_CORRUPTED: ranges = &m_batch.corrupted; break;
+    default: return;
+    }
+
+    if (m_batchEvents == 0) {
+        m_batchStart = std::chrono::steady_clock::now();
+    }
+
+    // 앞 구간에 바로 이어지면 늘리기만 한다 (순서대로 도착하면 구간 하나로 유지)
+    if (!ranges->empty() && ranges->back().end == first) {
+        ranges->back().end += count;
+    } else {
+        ranges->push_back({first, first + count});
+    }
+    m_batchEvents += count;
+}
+
+bool UDPModel::TakeBatchLocked(UdpProgressBatch& out, bool force) {
+    if (!m_batchCallback || m_batchEvents == 0) return false;
+
+    if (!force) {
+        bool thresholdHit = m_batchThreshold > 0 && m_batchEvents >= m_batchThreshold;
+        if (!thresholdHit && std::chrono::steady_clock::now() - m_batchStart < m_batchInterval) {
+            return false;
+        }
+    }
+
+    out = std::move(m_batch);
+    out.sessionId = m_sessionId;
+    out.receivedCount = m_receivedCount;
+    out.totalPackets = m_totalPackets;
+
+    // 순서가 뒤섞여 도착한 구간을 정리
+    NormalizeRanges(out.received);
+    NormalizeRanges(out.recovered);
+    NormalizeRanges(out.local);
+    NormalizeRanges(out.corrupted);
+
+    m_batch = UdpProgressBatch{};
+    m_batchEvents = 0;
+    return true;
+}
+
+int UDPModel::SetFecParams(uint32_t k, uint32_t m) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 스트리밍 창은 지나간 청크를 들고 있지 않으므로 패리티로 복원할 수 없다
+    if (m != 0 && (m_stream || k == 0 || m > k)) {
+        return -1;
+    }
+
+    m_fecK = k;
+    m_fecM = m;
+
+    uint64_t parityCount = (m == 0) ? 0 : FecGroupCount(m_totalPackets, k) * m;
+    m_parityBuffer.assign(parityCount, {});
+    m_parityReceived.assign(parityCount, false);
+    return 1;
+}
+
+bool UDPModel::MarkReceivedLocked(uint64_t index) {
+    if (m_receivedStatus[index]) {
+        m_ackPending.push_back(index);
+        return true;
+    }
+
+    // 이어받기 모드: 청크 위치에 먼저 기록하고, 기록에 성공했을 때만 받은 것으로 친다
+    // (0 청크는 기록하지 않는다 -> 출력 파일의 구멍으로 남음)
+    if (m_resumable && m_zeroLength[index] == 0) {
+        const auto& chunk = m_packetBuffer[index];
+        off_t offset = static_cast<off_t>(index * m_identity.chunkSize);
+        if (pwrite(m_outFd, chunk.data(), chunk.size(), offset) != static_cast<ssize_t>(chunk.size())) {
+            // 비트맵/ACK 에 남기지 않는다 -> 빠진 청크로 다시 요청됨
+            ReleaseChunkLocked(index);
+            return false;
+        }
+
+        // 기록한 청크는 메모리에 두지 않는다 (필요하면 ChunkLocked 가 파일에서 다시 읽음)
+        // 바로 다이제스트에 들어갈 청크만 AdvanceDigestLocked 가 쓰고 나서 내린다
+        if (index != m_digestNext) {
+            ReleaseChunkLocked(index);
+        }
+    }
+
+    m_receivedStatus[index] = true;
+    ++m_receivedCount;
+    m_ackPending.push_back(index);
+
+    // 비트맵은 모아서 반영
+    if (m_resumable) {
+        m_unflushed.push_back(index);
+        if (m_unflushed.size() >= RESUME_FLUSH_INTERVAL) {
+            FlushResumeLocked();
+        }
+    }
+    return true;
+}
+
+void UDPModel::ReleaseChunkLocked(uint64_t index) {
+    auto& chunk = m_packetBuffer[index];
+    m_bufferBudget.Resize(m_bufferBudget.Bytes() - std::min<uint64_t>(chunk.size(), m_bufferBudget.Bytes()));
+    std::vector<unsigned char>().swap(chunk);
+}
+
+const std::vector<unsigned char>& UDPModel::ChunkLocked(uint64_t index) {
+    auto& chunk = m_packetBuffer[index];
+    if (chunk.empty() && m_zeroLength[index] > 0) {
+        chunk.assign(m_zeroLength[index], 0);
+        // 이미 받은 청크의 내용을 만드는 것이므로 한도와 상관없이 예산에 반영
+        m_bufferBudget.Resize(m_bufferBudget.Bytes() + chunk.size());
+    }
+    else if (chunk.empty() && m_resumable && m_receivedStatus[index]) {
+        // 출력 파일에 기록된 청크: 임시 버퍼로 읽어온다 (청크마다 메모리에 다시 쌓지 않도록)
+        uint64_t offset = index * m_identity.chunkSize;
+        uint64_t length = std::min<uint64_t>(m_identity.chunkSize, m_identity.fileSize - offset);
+        std::size_t capacity = m_chunkScratch.capacity();
+        m_chunkScratch.resize(length);
+        if (pread(m_outFd, m_chunkScratch.data(), length, static_cast<off_t>(offset)) != static_cast<ssize_t>(length)) {
+            m_chunkScratch.clear();
+        }
+        if (m_chunkScratch.capacity() > capacity) {
+            m_bufferBudget.Resize(m_bufferBudget.Bytes() + (m_chunkScratch.capacity() - capacity));
+        }
+        return m_chunkScratch;
+    }
+    return chunk;
+}
+
+void UDPModel::FlushResumeLocked() {
+    if (!m_resumable || m_unflushed.empty()) {
+        return;
+    }
+
+    // 1. 데이터 먼저 디스크에 반영
+    fdatasync(m_outFd);
+
+    // 2. 그다음 비트맵과 다이제스트 진행 상태 갱신
+    unsigned char* bits = m_map + sizeof(ResumeMapHeader);
+    for (uint64_t index : m_unflushed) {
+        bits[index / 8] |= static_cast<unsigned char>(1u << (index % 8));
+    }
+    m_unflushed.clear();
+
+    auto* header = reinterpret_cast<ResumeMapHeader*>(m_map);
+    header->digestNext = m_digestNext;
+    header->digestBytes = m_fileDigest.Bytes();
+    header->digestCrc = m_fileDigest.Value();
+
+    msync(m_map, m_mapSize, MS_ASYNC);
+}
+
+void UDPModel::CloseResumeLocked(bool completed) {
+    if (m_resumable && !completed) {
+        FlushResumeLocked();
+    }
+
+    if (m_map) {
+        munmap(m_map, m_mapSize);
+        m_map = nullptr;
+    }
+    if (m_mapFd != -1) {
+        close(m_mapFd);
+        m_mapFd = -1;
+    }
+    if (m_outFd != -1) {
+        if (completed) fdatasync(m_outFd);
+        close(m_outFd);
+        m_outFd = -1;
+    }
+    if (completed) {
+        std::string mapPath = m_oUDPutFilename + RESUME_SUFFIX;
+        unlink(mapPath.c_str());
+    }
+
+    m_unflushed.clear();
+    m_mapSize = 0;
+    m_resumable = false;
+}
+
+std::vector<PacketRange> UDPModel::GetMissingRanges() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 스트리밍: 창 안의 빈 칸만 (창 뒤쪽은 아직 받을 수 없으므로 요청하지 않는다)
+    if (m_stream) {
+        return m_stream->MissingRanges();
+    }
+
+    return MissingRangesLocked(0, m_totalPackets);
+}
+
+std::vector<PacketRange> UDPModel::GetMissingRangesWithin(uint64_t begin, uint64_t end) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return MissingRangesLocked(begin, std::min(end, m_totalPackets));
+}
+
+std::vector<PacketRange> UDPModel::MissingRangesLocked(uint64_t begin, uint64_t end) const {
+    auto received = [this](uint64_t i) {
+        return m_stream ? m_stream->IsReceived(i) : static_cast<bool>(m_receivedStatus[i]);
+    };
+
+    std::vector<PacketRange> ranges;
+    for (uint64_t i = begin; i < end; ++i) {
+        if (received(i)) continue;
+
+        uint64_t first = i;
+        while (i < end && !received(i)) ++i;
+        ranges.push_back({first, i});
+    }
+    return ranges;
+}
+
+bool UDPModel::DecompressIntoLocked(std::vector<unsigned char>& chunk, const unsigned char* payload, uint32_t length) {
+    uint32_t rawLength = 0;
+    if (!LzReadRawLength(payload, length, rawLength) || rawLength > MAX_RAW_CHUNK_BYTES) {
+        return false;
+    }
+
+    // 중간 버퍼 없이 최종 저장 위치에 바로 복원
+    chunk.resize(rawLength);
+    if (!LzDecompress(payload, length, chunk.data(), chunk.size())) {
+        chunk.clear();
+        return false;
+    }
+    return true;
+}
+
+bool UDPModel::DecodeZeroRangeLocked(const unsigned char* payload, uint32_t length, ZeroRange& range) const {
+    if (!DecodeZeroRange(payload, length, range)) {
+        return false;
+    }
+
+    // 청크 길이는 상대가 보낸 값이므로 이 세션의 청크 크기를 넘으면 버린다
+    // (0 청크를 버퍼로 만들 때 크기를 마음대로 잡지 못하도록)
+    uint32_t maxChunk = m_resumable ? m_identity.chunkSize : MAX_RAW_CHUNK_BYTES;
+    return range.chunkLength <= maxChunk;
+}
+
+void UDPModel::AdvanceDigestLocked() {
+    // 스트리밍 모드는 싱크로 기록하면서 창이 직접 누적한다
+    if (m_stream) return;
+
+    // 앞에서부터 연속된 구간이 늘어난 만큼 파일 다이제스트 누적
+    while (m_digestNext < m_totalPackets && m_receivedStatus[m_digestNext]) {
+        if (m_zeroLength[m_digestNext] > 0) {
+            // 0 청크는 버퍼를 만들지 않고 0 버퍼로 누적 (0 버퍼 크기씩 나눠서)
+            for (uint32_t left = m_zeroLength[m_digestNext]; left > 0; ) {
+                uint32_t n = std::min<uint32_t>(left, ZERO_BUFFER_BYTES);
+                m_fileDigest.Update(ZeroBuffer(), n);
+                left -= n;
+            }
+        } else {
+            const auto& chunk = ChunkLocked(m_digestNext);
+            m_fileDigest.Update(chunk.data(), chunk.size());
+
+            // 이어받기 모드: 파일에 이미 기록한 청크는 다이제스트에 넣은 뒤 메모리에서 내린다
+            if (m_resumable && !m_packetBuffer[m_digestNext].empty()) {
+                ReleaseChunkLocked(m_digestNext);
+            }
+        }
+        ++m_digestNext;
+    }
+}
+
+void UDPModel::AppendRecovered(std::vector<uint64_t>& recovered, uint64_t index) {
+    if (index != NO_PACKET) {
+        recovered.push_back(index);
+    }
+}
+
+uint64_t UDPModel::TryRecoverStripeLocked(uint64_t parityIndex) {
+    if (!m_parityReceived[parityIndex]) {
+        return NO_PACKET;
+    }
+
+    // 스트라이프에 속한 데이터 청크: first + j, first + j + m, ... (< last)
+    uint64_t group = parityIndex / m_fecM;
+    uint64_t j     = parityIndex % m_fecM;
+    uint64_t first = group * m_fecK;
+    uint64_t last  = std::min<uint64_t>(first + m_fecK, m_totalPackets);
+
+    // 빠진 청크가 정확히 1개일 때만 복원 가능
+    uint64_t missing = NO_PACKET;
+    for (uint64_t i = first + j; i < last; i += m_fecM) {
+        if (!m_receivedStatus[i]) {
+            if (missing != NO_PACKET) return NO_PACKET;
+            missing = i;
+        }
+    }
+    if (missing == NO_PACKET) {
+        return NO_PACKET;
+    }
+
+    // 패리티에 나머지 청크들을 XOR 하면 빠진 청크가 남는다
+    std::vector<unsigned char> work = m_parityBuffer[parityIndex];
+    unsigned char* lenBytes = work.data();
+    unsigned char* data     = work.data() + FEC_PARITY_LEN_BYTES;
+    std::size_t dataLen     = work.size() - FEC_PARITY_LEN_BYTES;
+
+    uint32_t length = 0;
+    for (std::size_t b = 0; b < FEC_PARITY_LEN_BYTES; ++b)
+        length |= static_cast<uint32_t>(lenBytes[b]) << (8 * b);
+
+    for (uint64_t i = first + j; i < last; i += m_fecM) {
+        if (i == missing) continue;
+        if (m_zeroLength[i] > 0) {
+            length ^= m_zeroLength[i]; // 0 과의 XOR 은 길이만 반영
+            continue;
+        }
+        const auto& chunk = ChunkLocked(i);
+        length ^= static_cast<uint32_t>(chunk.size());
+        FecXorInto(data, chunk.data(), std::min(chunk.size(), dataLen));
+    }
+
+    if (length > dataLen) {
+        return NO_PACKET; // 패리티와 데이터가 맞지 않음 (복원 포기, 재전송에 맡김)
+    }
+    if (!m_bufferBudget.TryGrow(length)) {
+        return NO_PACKET; // 예산 초과 (재전송에 맡김)
+    }
+
+    m_packetBuffer[missing].assign(data, data + length);
+    if (!MarkReceivedLocked(missing)) {
+        return NO_PACKET;
+    }
+    return missing;
+}
+
+std::vector<PacketRange> UDPModel::TakeAckRanges() {
+    std::vector<uint64_t> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending.swap(m_ackPending);
+    }
+
+    // 정렬 후 이어진 번호끼리 묶는다
+    std::sort(pending.begin(), pending.end());
+    std::vector<PacketRange> ranges;
+    for (uint64_t index : pending) {
+        if (!ranges.empty() && index <= ranges.back().end) {
+            ranges.back().end = std::max(ranges.back().end, index + 1);
+        } else {
+            ranges.push_back({index, index + 1});
+        }
+    }
+    return ranges;
+}
+
+bool UDPModel::IsSessionComplete() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stream) {
+        return m_totalPackets > 0 && m_stream->IsDrained();
+    }
+    return m_totalPackets > 0 && m_receivedCount == m_totalPackets;
+}
+
+int UDPModel::ExportPackets(std::vector<Packet>& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stream || m_totalPackets == 0 || m_receivedCount != m_totalPackets) {
+        return -1;
+    }
+
+    out.clear();
+    out.reserve(m_totalPackets);
+    for (uint64_t i = 0; i < m_totalPackets; ++i) {
+        Packet p;
+        p.seq = static_cast<uint32_t>(i);
+
+        if (m_zeroLength[i] > 0) {
+            p.data  = EncodeZeroRange({1, m_zeroLength[i], m_zeroLength[i]});
+            p.flags = PACKET_FLAG_ZERO;
+        }
+        else {
+            const auto& chunk = ChunkLocked(i);
+            p.data.assign(chunk.begin(), chunk.end());
+        }
+        p.length   = static_cast<uint32_t>(p.data.size());
+        p.checksum = Crc32c(p.data.data(), p.data.size());
+        out.push_back(std::move(p));
+    }
+    return 1;
+}
+
+uint32_t UDPModel::GetFileDigest() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stream ? m_stream->Digest() : m_fileDigest.Value();
 }
\ No newline at end of file
@@ -2,17 +2,18 @@
 #define UDP_MODEL_H
 
 #include "IUDPModel.h"
+#include "UdpPacketHeader.h"
+#include "Fec.h"
+#include "Lz.h"
+#include "ZeroRange.h"
+#include "MemoryBudget.h"
+#include "StreamWindow.h"
+#include "IFileSplitterAndMerger.h" // PACKET_FLAG_*
 #include <vector>
 #include <string>
 #include <mutex>
-
-#pragma pack(push, 1)
-struct UdpPacketHeader {
-    uint64_t session_id;
-    uint64_t packet_index;
-    uint32_t data_length;
-};
-#pragma pack(pop)
+#include <chrono>
+#include <memory>
 
 class UDPModel : public IUDPModel {
 private:
@@ -24,6 +25,42 @@ private:
     // 데이터 버퍼 (vector 사용 권장)
     std::vector<std::vector<unsigned char>> m_packetBuffer;
     std::vector<bool> m_receivedStatus;
+    // 0 구간 표식으로 받은 청크의 길이 (0이면 일반 데이터 청크, 버퍼를 만들지 않는다)
+    std::vector<uint32_t> m_zeroLength;
+    uint64_t m_receivedCount;
+
+    // 청크/패리티 버퍼가 차지한 프로세스 메모리 예산 (MEM_RECV_BUFFERS, 세션이 바뀌면 반납)
+    MemoryReservation m_bufferBudget;
+
+    // 파일 전체 다이제스트 (앞에서부터 연속으로 도착한 구간까지 누적)
+    Crc32cDigest m_fileDigest;
+    uint64_t m_digestNext;
+
+    // FEC 패리티 (m_fecM == 0 이면 사용 안 함)
+    uint32_t m_fecK;
+    uint32_t m_fecM;
+    std::vector<std::vector<unsigned char>> m_parityBuffer;
+    std::vector<bool> m_parityReceived;
+
+    // 이어받기(resume) 모드: 출력 파일 + mmap 된 완료 비트맵 사이드카
+    bool m_resumable;
+    UdpFileIdentity m_identity;
+    int m_outFd;
+    int m_mapFd;
+    unsigned char* m_map;       // 사이드카 전체 매핑 (헤더 + 비트맵)
+    std::size_t m_mapSize;
+    std::vector<uint64_t> m_unflushed; // 디스크에 썼지만 아직 비트맵에 반영하지 않은 청크
+    // 기록한 청크는 m_packetBuffer 에서 내리므로, 다시 필요하면 이 버퍼 하나로 읽어온다
+    std::vector<unsigned char> m_chunkScratch;
+
+    // 스트리밍 모드: 재정렬 창 (없으면 일반 모드)
+    // 이 모드에서는 패킷 수만큼 잡는 버퍼/상태 벡터를 쓰지 않는다
+    std::unique_ptr<StreamWindow> m_stream;
+    uint64_t m_reportedWindowEnd; // 마지막으로 TakeWindowUpdate 가 알린 상한
+    bool m_windowUpdateDue;       // 창 밖 패킷이 들어와서 상한을 다시 알려야 함
+
+    // 아직 FILE_ACK 로 알리지 않은 수신 패킷 번호 (중복 수신 포함)
+    std::vector<uint64_t> m_ackPending;
     
     // 동기화를 위한 뮤텍스
     std::mutex m_mutex;
@@ -31,15 +68,78 @@ private:
     // 콜백 함수 저장소
     UdpPacketCallback m_callback;
 
+    // 배치 옵저버 (m_batchCallback 이 비어 있으면 이벤트를 모으지 않는다)
+    UdpBatchCallback m_batchCallback;
+    std::chrono::milliseconds m_batchInterval;
+    uint64_t m_batchThreshold;
+    UdpProgressBatch m_batch;    // 아직 전달하지 않은 이벤트
+    uint64_t m_batchEvents;      // m_batch 에 쌓인 패킷 수
+    std::chrono::steady_clock::time_point m_batchStart; // 첫 이벤트가 쌓인 시각
+
+    static constexpr uint64_t NO_PACKET = UINT64_MAX;
+
+    // 압축 청크가 주장하는 원본 길이 상한 (비정상 길이로 메모리를 잡는 것 방지)
+    static constexpr uint32_t MAX_RAW_CHUNK_BYTES = 64 * 1024;
+
+    // 이만큼 청크를 기록할 때마다 비트맵을 디스크에 반영
+    static constexpr std::size_t RESUME_FLUSH_INTERVAL = 1024;
+
+    // 아래 함수들은 m_mutex 를 잡은 상태에서만 호출
+    void ResetSessionLocked(uint64_t sessionId, uint64_t totalPackets, const char* filename);
+    // 받은 것으로 표시하고 ACK 대기에 추가 (이어받기 모드는 출력 파일 기록이 실패하면 false)
+    bool MarkReceivedLocked(uint64_t index);
+    // 청크 버퍼를 비우고 예산에서 뺀다
+    void ReleaseChunkLocked(uint64_t index);
+    // 압축 payload 를 chunk 에 바로 풀어 쓴다 (실패 시 false)
+    bool DecompressIntoLocked(std::vector<unsigned char>& chunk, const unsigned char* payload, uint32_t length);
+    // 스트리밍 모드의 데이터/0 구간 패킷 저장 후 싱크로 흘려 보냄 (결과는 ProcessReceivedPacket 반환값)
+    int StoreStreamLocked(const UdpPacketHeader& header, const unsigned char* payload,
+                          uint64_t& zeroCount, bool& corrupted);
+    // [begin, end) 안의 빠진 구간 (end 는 m_totalPackets 이하)
+    std::vector<PacketRange> MissingRangesLocked(uint64_t begin, uint64_t end) const;
+    // 0 구간 표식을 읽고 청크 길이가 세션 청크 크기 이하인지 확인 (아니면 false)
+    bool DecodeZeroRangeLocked(const unsigned char* payload, uint32_t length, ZeroRange& range) const;
+    void AdvanceDigestLocked();
+    // 청크 데이터 (이어받기 모드에서 파일에 기록한 청크는 m_chunkScratch 로 읽어온다
+    // -> 다음 ChunkLocked 호출 전까지만 유효)
+    const std::vector<unsigned char>& ChunkLocked(uint64_t index);
+    // 데이터를 먼저 fdatasync 한 뒤 비트맵을 갱신/msync (충돌 시 비트맵이 데이터보다 앞서지 않도록)
+    void FlushResumeLocked();
+    // 사이드카/출력 파일 정리 (completed 면 사이드카 삭제)
+    void CloseResumeLocked(bool completed);
+    // 스트라이프의 손실이 1개면 복원하고 그 인덱스를 반환 (아니면 NO_PACKET)
+    uint64_t TryRecoverStripeLocked(uint64_t parityIndex);
+    static void AppendRecovered(std::vector<uint64_t>& recovered, uint64_t index);
+    // [first, first + count) 구간의 status 이벤트를 배치에 쌓는다
+    void RecordEventLocked(uint64_t first, uint64_t count, int status);
+    // 전달할 때가 됐으면 (또는 force) 쌓인 배치를 out 으로 꺼낸다
+    bool TakeBatchLocked(UdpProgressBatch& out, bool force);
+
 public:
     UDPModel();
     virtual ~UDPModel();
 
     // 인터페이스 구현부 (override 키워드로 명시)
     int InitializeSession(uint64_t sessionId, uint64_t totalPackets, const char* filename) override;
+    int InitializeResumableSession(uint64_t sessionId, uint64_t totalPackets,
+                                   const char* filename, const UdpFileIdentity& identity) override;
+    int InitializeStreamingSession(uint64_t sessionId, uint64_t totalPackets,
+                                   int sinkFd, uint32_t windowPackets) override;
+    bool TakeWindowUpdate(uint64_t& windowEnd) override;
+    int64_t FlushStream() override;
+    std::vector<PacketRange> GetMissingRanges() override;
+    std::vector<PacketRange> GetMissingRangesWithin(uint64_t begin, uint64_t end) override;
+    std::vector<PacketRange> TakeAckRanges() override;
     int ProcessReceivedPacket(const unsigned char* rawData, int length) override;
+    int StoreLocalChunk(uint64_t packetIndex, const unsigned char* data, uint32_t length) override;
     int SendData(const unsigned char* data, int length) override;
     void SetStatusCallback(UdpPacketCallback callback) override;
+    void SetBatchCallback(UdpBatchCallback callback, uint32_t intervalMs, uint64_t packetThreshold) override;
+    void FlushNotifications() override;
+    int SetFecParams(uint32_t k, uint32_t m) override;
+    bool IsSessionComplete() override;
+    int ExportPackets(std::vector<Packet>& out) override;
+    uint32_t GetFileDigest() override;
 };
 
 #endif 
\ No newline at end of file
@@ -1,5 +1,6 @@
 // main.cpp
 #include <iostream>
+#include <cstring>
 #include "UDPModel.h"
 
 int main() {
@@ -16,17 +17,42 @@ int main() {
     // 3. 세션 초기화 테스트
     model->InitializeSession(100, 5, "test.txt");
 
-    // 4. 가짜 데이터 수신 테스트 (패킷 헤더 + 데이터) 
-    // 헤더 구조: [SessionID(8)][PacketIdx(8)][DataLen(4)] + [Data...]
-    struct {
-        uint64_t sid = 100;
-        uint64_t pidx = 0;
-        uint32_t len = 5;
-        char data[5] = {'H', 'e', 'l', 'l', 'o'};
-    } dummyPacket;
-
-    // 강제로 char* 로 캐스팅해서 넣어봄
-    model->ProcessReceivedPacket((unsigned char*)&dummyPacket, sizeof(dummyPacket));
+    // 4. 가짜 데이터 수신 테스트 (패킷 헤더 + 데이터)
+    // 헤더는 big-endian 와이어 형식으로 인코딩해서 payload 앞에 붙인다 (UdpPacketHeader.h 참고)
+    const char data[5] = {'H', 'e', 'l', 'l', 'o'};
+    unsigned char dummyPacket[UDP_HEADER_BYTES + sizeof(data)];
+
+    UdpPacketHeader header{};
+    header.session_id = 100;
+    header.packet_index = 0;
+    header.total_packets = 5;
+    header.data_length = sizeof(data);
+    std::memcpy(dummyPacket + UDP_HEADER_BYTES, data, sizeof(data));
+    SealUdpPacketHeader(header, Crc32c(data, sizeof(data)), dummyPacket);
+
+    model->ProcessReceivedPacket(dummyPacket, sizeof(dummyPacket));
+
+    // 5. 데이터가 깨진 패킷은 체크섬 검증에서 걸러져야 함 (Status: -2)
+    dummyPacket[UDP_HEADER_BYTES] = 'J';
+    model->ProcessReceivedPacket(dummyPacket, sizeof(dummyPacket));
+
+    // 6. 배치 옵저버: 패킷마다가 아니라 구간으로 묶어서 한 번에 받음
+    model->SetBatchCallback([](const UdpProgressBatch& batch) {
+        std::cout << "[Batch] " << FormatProgressBatch(batch) << std::endl;
+    }, 100, 1024);
+
+    dummyPacket[UDP_HEADER_BYTES] = 'H';
+    for (uint64_t i = 1; i < 5; ++i) {
+        header = UdpPacketHeader{};
+        header.session_id = 100;
+        header.packet_index = i;
+        header.total_packets = 5;
+        header.data_length = sizeof(data);
+        if (i == 4) header.flags = UDP_FLAG_LAST_CHUNK;
+        SealUdpPacketHeader(header, Crc32c(data, sizeof(data)), dummyPacket);
+        model->ProcessReceivedPacket(dummyPacket, sizeof(dummyPacket));
+    }
+    model->FlushNotifications();
 
     delete model;
     return 0;
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "UdpPacketHeader.h"
+
+/**
+ * @brief UDP 헤더 디코딩 비용 측정용 main 함수
+ *
+ * 1. 서로 다른 값의 헤더 4096개를 와이어 형식(big-endian)으로 인코딩해 둔다.
+ *    (패킹된 예전 구조체용 버퍼도 같은 값으로 만들어 둔다)
+ * 2. DecodeUdpPacketHeader (WireCodec) 로 전부 읽는 데 걸리는 시간과
+ *    예전 방식(#pragma pack 구조체를 reinterpret_cast)으로 읽는 시간을 비교한다.
+ * 3. 두 방식 모두 같은 필드 5개를 읽어 합산하므로 읽지 않은 필드가 최적화로 빠지는 차이는 없다.
+ */
+namespace {
+
+// 예전 헤더 (호스트 엔디언, 패킹) - 비교용으로만 사용
+#pragma pack(push, 1)
+struct LegacyHeader {
+    uint64_t session_id;
+    uint64_t packet_index;
+    uint64_t total_packets;
+    uint32_t data_length;
+    uint32_t checksum;
+};
+#pragma pack(pop)
+
+constexpr std::size_t HEADER_COUNT = 4096;
+constexpr int ROUNDS = 20000;
+
+} // namespace
+
+int main() {
+    // ============================================================
+    // 1) 헤더 준비
+    // ============================================================
+    std::vector<unsigned char> wireBuffer(HEADER_COUNT * UDP_HEADER_BYTES);
+    std::vector<unsigned char> legacyBuffer(HEADER_COUNT * sizeof(LegacyHeader));
+
+    for (std::size_t i = 0; i < HEADER_COUNT; ++i) {
+        UdpPacketHeader header{};
+        header.session_id = 0x100000000ull + i;
+        header.packet_index = i * 3;
+        header.total_packets = HEADER_COUNT * 3;
+        header.data_length = static_cast<uint32_t>(1024 - (i & 63));
+        SealUdpPacketHeader(header, static_cast<uint32_t>(i * 2654435761u), wireBuffer.data() + i * UDP_HEADER_BYTES);
+
+        LegacyHeader legacy{header.session_id, header.packet_index, header.total_packets,
+                            header.data_length, header.checksum};
+        std::memcpy(legacyBuffer.data() + i * sizeof(LegacyHeader), &legacy, sizeof(legacy));
+    }
+
+    // ============================================================
+    // 2) WireCodec 디코딩
+    // ============================================================
+    uint64_t sumCodec = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (std::size_t i = 0; i < HEADER_COUNT; ++i) {
+            UdpPacketHeader header;
+            DecodeUdpPacketHeader(wireBuffer.data() + i * UDP_HEADER_BYTES, header);
+            sumCodec += header.session_id + header.packet_index + header.total_packets
+                      + header.data_length + header.checksum;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // ============================================================
+    // 3) 예전 방식: 패킹 구조체 reinterpret_cast (엔디언/정렬 처리 없음)
+    // ============================================================
+    uint64_t sumLegacy = 0;
+    auto t2 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (std::size_t i = 0; i < HEADER_COUNT; ++i) {
+            const auto* header = reinterpret_cast<const LegacyHeader*>(legacyBuffer.data() + i * sizeof(LegacyHeader));
+            sumLegacy += header->session_id + header->packet_index + header->total_packets
+                       + header->data_length + header->checksum;
+        }
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    double count = static_cast<double>(HEADER_COUNT) * ROUNDS;
+    double codecNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+    double legacyNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / count;
+
+    std::cout << "same values: " << (sumCodec == sumLegacy) << "\n";
+    std::cout << "WireCodec decode: " << codecNs << " ns/header\n";
+    std::cout << "packed reinterpret_cast: " << legacyNs << " ns/header\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef UDP_PACKET_HEADER_H
+#define UDP_PACKET_HEADER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Crc32c.h"
+#include "WireCodec.h"
+
+// UDP 데이터그램 헤더 (와이어는 big-endian, 버전 1)
+// 구조: [Version(1)][Flags(1)][PayloadOffset(2)][SessionID(8)][PacketIdx(8)]
+//       [TotalPackets(8)][DataLen(4)][Checksum(4)] + [Data...]
+// 메모리의 이 구조체는 호스트 순서 값이고, 와이어 변환은 EncodeUdpPacketHeader / DecodeUdpPacketHeader 로만 한다.
+struct UdpPacketHeader {
+    uint8_t  version;        // UDP_HEADER_VERSION
+    uint8_t  flags;          // 하위 4비트: PACKET_FLAG_* (Packet::flags 그대로), 상위: UDP_FLAG_*
+    uint16_t payload_offset; // 데이터그램 시작부터 payload 까지 바이트 수 (뒤 버전의 헤더 확장용)
+    uint64_t session_id;
+    uint64_t packet_index;
+    uint64_t total_packets;  // 전송 전체 데이터 청크 수 (패리티 제외)
+    uint32_t data_length;
+    uint32_t checksum;       // CRC32C(payload) 에 이어서 checksum 앞까지의 헤더 바이트를 누적한 값
+};
+
+// 와이어 필드 순서 (이 목록 하나로 인코더/디코더와 오프셋이 만들어진다)
+using UdpHeaderCodec = WireCodec<
+    &UdpPacketHeader::version,
+    &UdpPacketHeader::flags,
+    &UdpPacketHeader::payload_offset,
+    &UdpPacketHeader::session_id,
+    &UdpPacketHeader::packet_index,
+    &UdpPacketHeader::total_packets,
+    &UdpPacketHeader::data_length,
+    &UdpPacketHeader::checksum>;
+
+constexpr uint8_t UDP_HEADER_VERSION = 1;
+
+// 이 버전이 쓰는 헤더 바이트 수
+constexpr std::size_t UDP_HEADER_BYTES = UdpHeaderCodec::SIZE;
+
+// 체크섬 계산에 포함되는 헤더 바이트 수 (마지막 필드인 checksum 자신은 제외)
+constexpr std::size_t UDP_HEADER_CHECKSUM_SPAN = UdpHeaderCodec::OFFSETS[UdpHeaderCodec::COUNT - 1];
+
+static_assert(UDP_HEADER_BYTES == 36, "UDP header v1 layout changed");
+static_assert(UDP_HEADER_CHECKSUM_SPAN + sizeof(uint32_t) == UDP_HEADER_BYTES, "checksum must be the last field");
+
+// 와이어 전용 플래그 (하위 4비트는 Packet::flags 가 쓴다)
+constexpr uint8_t UDP_FLAG_PARITY     = 0x10; // FEC 패리티 청크 (packet_index >= total_packets)
+constexpr uint8_t UDP_FLAG_LAST_CHUNK = 0x20; // 마지막 데이터 청크를 포함
+constexpr uint8_t UDP_FLAG_CHECKSUM   = 0x80; // checksum 필드가 유효함 (v1 에서는 항상 켜짐, 꺼져 있으면 깨진 데이터그램)
+
+// 헤더를 out[0, UDP_HEADER_BYTES) 에 기록 (checksum 필드도 header 값 그대로)
+inline void EncodeUdpPacketHeader(const UdpPacketHeader& header, unsigned char* out)
+{
+    UdpHeaderCodec::Encode(header, out);
+}
+
+// in[0, UDP_HEADER_BYTES) 를 읽음 (버전/길이 검증은 호출하는 쪽에서)
+inline void DecodeUdpPacketHeader(const unsigned char* in, UdpPacketHeader& header)
+{
+    UdpHeaderCodec::Decode(in, header);
+}
+
+/**
+ * @brief 인코딩된 헤더로 데이터그램 체크섬을 계산한다.
+ *
+ * @param encoded     와이어 형태 헤더 (checksum 앞까지만 읽는다)
+ * @param payloadCrc  payload 의 CRC32C (Packet::checksum 을 그대로 재사용 가능)
+ */
+inline uint32_t ComputeUdpPacketChecksum(const unsigned char* encoded, uint32_t payloadCrc)
+{
+    return Crc32c(encoded, UDP_HEADER_CHECKSUM_SPAN, payloadCrc);
+}
+
+/**
+ * @brief 헤더 구조체로 데이터그램 체크섬을 계산한다.
+ *
+ * @details
+ *   - payload CRC 를 먼저 계산해 두면 재전송 때 payload 를 다시 훑지 않아도 된다.
+ */
+inline uint32_t ComputeUdpPacketChecksum(const UdpPacketHeader& header, uint32_t payloadCrc)
+{
+    unsigned char encoded[UDP_HEADER_BYTES];
+    EncodeUdpPacketHeader(header, encoded);
+    return ComputeUdpPacketChecksum(encoded, payloadCrc);
+}
+
+/**
+ * @brief 버전/오프셋/체크섬을 채워서 헤더를 out 에 기록한다. (송신용)
+ *
+ * @param header      session_id, packet_index, total_packets, data_length, flags 가 채워진 헤더
+ * @param payloadCrc  payload 의 CRC32C
+ * @param out         UDP_HEADER_BYTES 이상인 버퍼 (payload 는 바로 뒤에 붙인다)
+ */
+inline void SealUdpPacketHeader(UdpPacketHeader& header, uint32_t payloadCrc, unsigned char* out)
+{
+    header.version = UDP_HEADER_VERSION;
+    header.payload_offset = static_cast<uint16_t>(UDP_HEADER_BYTES);
+    header.flags |= UDP_FLAG_CHECKSUM;
+    header.checksum = 0;
+
+    EncodeUdpPacketHeader(header, out);
+    header.checksum = ComputeUdpPacketChecksum(out, payloadCrc);
+    wire::StoreBE(out + UDP_HEADER_CHECKSUM_SPAN, header.checksum);
+}
+
+#endif // UDP_PACKET_HEADER_H
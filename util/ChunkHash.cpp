@@ -0,0 +1,58 @@
+#include "ChunkHash.h"
+
+#include <cstring> // memcpy
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t Rotl(uint64_t v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input)
+{
+    acc += input * kPrime2;
+    acc = Rotl(acc, 31);
+    return acc * kPrime1;
+}
+
+} // namespace
+
+// xxHash64 계열의 단일 레인 변형 (8바이트씩 섞고 마지막에 avalanche)
+uint64_t ChunkHash64(const void* data, std::size_t length)
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t h = kPrime5 + static_cast<uint64_t>(length);
+
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t k;
+        std::memcpy(&k, p + i, 8);
+        h ^= Round(0, k);
+        h = Rotl(h, 27) * kPrime1 + kPrime4;
+    }
+    if (i + 4 <= length) {
+        uint32_t k;
+        std::memcpy(&k, p + i, 4);
+        h ^= static_cast<uint64_t>(k) * kPrime1;
+        h = Rotl(h, 23) * kPrime2 + kPrime3;
+        i += 4;
+    }
+    for (; i < length; ++i) {
+        h ^= p[i] * kPrime5;
+        h = Rotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
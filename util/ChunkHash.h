@@ -0,0 +1,18 @@
+#ifndef CHUNK_HASH_H
+#define CHUNK_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 청크 중복 제거(dedup)에 쓰는 64비트 해시
+ *
+ * @details
+ *   - 같은 내용의 청크는 같은 값이 나오므로, 매니페스트의 해시만 비교해서
+ *     수신 측이 이미 가진 청크인지 판단한다.
+ *   - 암호학적 해시는 아니다. 청크 길이와 함께 비교하고,
+ *     파일 전체는 CRC32C 다이제스트로 한 번 더 검증한다.
+ */
+uint64_t ChunkHash64(const void* data, std::size_t length);
+
+#endif // CHUNK_HASH_H
@@ -0,0 +1,127 @@
+#include "Crc32c.h"
+
+#include <cstring> // memcpy
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h> // _mm_crc32_u8/u32/u64 (SSE4.2, u64 은 x86-64 전용)
+#define CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>  // __crc32cb/__crc32cd (ARMv8 CRC)
+#define CRC32C_ARM 1
+#endif
+
+namespace {
+
+// Castagnoli 다항식 (reflected)
+constexpr uint32_t kPoly = 0x82F63B78u;
+
+// ================================================================
+//  테이블 방식 (하드웨어 명령이 없을 때 사용)
+// ================================================================
+struct Crc32cTable {
+    uint32_t t[256];
+
+    constexpr Crc32cTable() : t{}
+    {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (c >> 1) ^ kPoly : (c >> 1);
+            t[i] = c;
+        }
+    }
+};
+
+constexpr Crc32cTable kTable{};
+
+uint32_t Crc32cSoftware(uint32_t crc, const unsigned char* p, std::size_t n)
+{
+    while (n--)
+        crc = kTable.t[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#if defined(CRC32C_X86)
+// ================================================================
+//  SSE4.2 crc32 명령 (x86-64 는 8바이트씩, 32비트 x86 은 4바이트씩 처리)
+// ================================================================
+__attribute__((target("sse4.2")))
+uint32_t Crc32cSse42(uint32_t crc, const unsigned char* p, std::size_t n)
+{
+#if defined(__x86_64__)
+    uint64_t c = crc;
+    while (n >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8); // 정렬되지 않은 주소도 안전하게 읽기
+        c = _mm_crc32_u64(c, v);
+        p += 8;
+        n -= 8;
+    }
+    uint32_t c32 = static_cast<uint32_t>(c);
+#else
+    uint32_t c32 = crc;
+    while (n >= 4) {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        c32 = _mm_crc32_u32(c32, v);
+        p += 4;
+        n -= 4;
+    }
+#endif
+    while (n--)
+        c32 = _mm_crc32_u8(c32, *p++);
+    return c32;
+}
+#endif
+
+#if defined(CRC32C_ARM)
+// ================================================================
+//  ARMv8 CRC 확장 명령 (8바이트씩 처리)
+// ================================================================
+uint32_t Crc32cArm(uint32_t crc, const unsigned char* p, std::size_t n)
+{
+    while (n >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+        p += 8;
+        n -= 8;
+    }
+    while (n--)
+        crc = __crc32cb(crc, *p++);
+    return crc;
+}
+#endif
+
+using Crc32cFn = uint32_t (*)(uint32_t, const unsigned char*, std::size_t);
+
+// 실행 환경에 맞는 구현을 한 번만 골라 둔다.
+Crc32cFn SelectCrc32c()
+{
+#if defined(CRC32C_X86)
+    if (__builtin_cpu_supports("sse4.2"))
+        return &Crc32cSse42;
+#elif defined(CRC32C_ARM)
+    return &Crc32cArm;
+#endif
+    return &Crc32cSoftware;
+}
+
+Crc32cFn Crc32cImpl()
+{
+    static const Crc32cFn fn = SelectCrc32c();
+    return fn;
+}
+
+} // namespace
+
+uint32_t Crc32c(const void* data, std::size_t length, uint32_t crc)
+{
+    // 표준 CRC32C 처럼 앞뒤로 비트 반전 (이어서 계산 가능하도록)
+    return ~Crc32cImpl()(~crc, static_cast<const unsigned char*>(data), length);
+}
+
+bool Crc32cIsHardwareAccelerated()
+{
+    return Crc32cImpl() != &Crc32cSoftware;
+}
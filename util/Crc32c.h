@@ -0,0 +1,64 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief CRC32C(Castagnoli) 체크섬을 계산한다.
+ *
+ * @param data    체크섬을 계산할 데이터
+ * @param length  데이터 바이트 수
+ * @param crc     이전 구간까지의 CRC 값 (처음 계산이면 0)
+ *
+ * @return 누적된 CRC32C 값
+ *
+ * @details
+ *   - x86 은 SSE4.2 crc32 명령, ARMv8 은 CRC 확장 명령을 사용하고,
+ *     둘 다 없으면 테이블 방식으로 계산한다. (런타임에 한 번만 선택)
+ *   - 이어서 계산이 가능하다:
+ *     Crc32c(b, nb, Crc32c(a, na)) == Crc32c(a+b, na+nb)
+ */
+uint32_t Crc32c(const void* data, std::size_t length, uint32_t crc = 0);
+
+/**
+ * @brief 현재 실행 환경에서 하드웨어 CRC 명령을 쓰고 있는지 여부
+ */
+bool Crc32cIsHardwareAccelerated();
+
+/**
+ * @brief 파일 전체 다이제스트를 청크 단위로 누적 계산하는 클래스
+ *
+ * - 청크가 들어오는 순서대로 Update 를 호출하면
+ *   파일 전체를 한 번에 계산한 것과 같은 값을 얻는다.
+ */
+class Crc32cDigest {
+public:
+    void Update(const void* data, std::size_t length)
+    {
+        m_crc = Crc32c(data, length, m_crc);
+        m_bytes += length;
+    }
+
+    uint32_t Value() const { return m_crc; }
+    uint64_t Bytes() const { return m_bytes; }
+
+    void Reset()
+    {
+        m_crc = 0;
+        m_bytes = 0;
+    }
+
+    // 저장해 둔 중간 상태에서 이어서 계산할 때 사용
+    void Restore(uint32_t crc, uint64_t bytes)
+    {
+        m_crc = crc;
+        m_bytes = bytes;
+    }
+
+private:
+    uint32_t m_crc = 0;
+    uint64_t m_bytes = 0;
+};
+
+#endif // CRC32C_H
@@ -0,0 +1,93 @@
+#include "Crc32c.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief CRC32C 처리량 측정용 main 함수
+ *
+ * 1. 알려진 값("123456789" -> 0xE3069283)으로 결과가 맞는지 먼저 확인한다.
+ * 2. 버퍼 크기별로 Crc32c (런타임에 고른 구현) 의 처리량(GB/s)을 잰다.
+ * 3. 같은 크기에서 바이트 단위 테이블 방식의 처리량도 재서 비교한다.
+ *    (하드웨어 명령을 못 쓰는 환경에서 Crc32c 가 내는 속도와 같다)
+ */
+namespace {
+
+// 비교용 바이트 단위 테이블 구현 (Crc32c.cpp 의 대체 경로와 같은 방식)
+uint32_t TableCrc32c(const unsigned char* p, std::size_t n)
+{
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : (c >> 1);
+            table[i] = c;
+        }
+        ready = true;
+    }
+
+    uint32_t crc = ~0u;
+    while (n--)
+        crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// 총 totalBytes 만큼 fn 을 반복 호출하고 GB/s 를 돌려준다
+template <typename Fn>
+double MeasureGBps(const std::vector<unsigned char>& buffer, std::size_t size, uint64_t totalBytes, Fn fn)
+{
+    uint64_t rounds = totalBytes / size + 1;
+    uint32_t sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint64_t r = 0; r < rounds; ++r)
+        sink ^= fn(buffer.data() + (r & 7), size); // 시작 주소를 조금씩 바꿔 정렬 안 된 경우도 포함
+    auto t1 = std::chrono::steady_clock::now();
+
+    if (sink == 0x12345678u) std::cout << ""; // 최적화로 호출이 사라지지 않도록
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(rounds * size) / seconds / 1e9;
+}
+
+} // namespace
+
+int main() {
+    // ============================================================
+    // 1) 정확성 확인 (CRC32C 표준 검사값)
+    // ============================================================
+    const char check[] = "123456789";
+    uint32_t value = Crc32c(check, 9);
+    std::cout << "check: " << std::hex << value << std::dec
+              << (value == 0xE3069283u ? " (ok)" : " (MISMATCH)") << "\n";
+    std::cout << "hardware: " << Crc32cIsHardwareAccelerated() << "\n";
+
+    // ============================================================
+    // 2) 크기별 처리량: 패킷 한 개(64B ~ 1KiB) 부터 파일 다이제스트(1MiB) 까지
+    // ============================================================
+    const std::size_t sizes[] = {64, 1024, 64 * 1024, 1024 * 1024};
+    const uint64_t totalBytes = 512ull << 20; // 크기마다 512 MiB 처리
+
+    std::vector<unsigned char> buffer(sizes[3] + 8);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<unsigned char>(i * 131 + (i >> 7));
+
+    for (std::size_t size : sizes) {
+        if (Crc32c(buffer.data(), size) != TableCrc32c(buffer.data(), size)) {
+            std::cout << "mismatch at size " << size << "\n";
+            return 1;
+        }
+
+        double fast = MeasureGBps(buffer, size, totalBytes, [](const unsigned char* p, std::size_t n) {
+            return Crc32c(p, n);
+        });
+        double table = MeasureGBps(buffer, size, totalBytes / 8, TableCrc32c);
+
+        std::cout << "size " << size << " B: Crc32c " << fast << " GB/s, table " << table << " GB/s\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "Fec.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h> // _mm_loadu_si128, _mm_xor_si128
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>  // vld1q_u8, veorq_u8
+#endif
+
+void FecXorInto(unsigned char* dst, const unsigned char* src, std::size_t n)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    // 64바이트(4 x 16) 단위로 풀어서 처리
+    for (; i + 64 <= n; i += 64) {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i + 16));
+        __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i + 32));
+        __m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i + 48));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+        __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+        __m128i b3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),      _mm_xor_si128(a0, b0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 16), _mm_xor_si128(a1, b1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 32), _mm_xor_si128(a2, b2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 48), _mm_xor_si128(a3, b3));
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, b));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= n; i += 16)
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+#endif
+
+    // 남은 바이트
+    for (; i < n; ++i)
+        dst[i] ^= src[i];
+}
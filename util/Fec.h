@@ -0,0 +1,45 @@
+#ifndef FEC_H
+#define FEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ================================================================
+//  XOR 패리티 기반 FEC (Forward Error Correction)
+//
+//  - 데이터 청크 K 개를 한 그룹으로 묶고, 그룹마다 패리티 청크 M 개를 만든다.
+//  - 그룹 안에서 (i % M) == j 인 데이터 청크들을 XOR 한 것이 j 번째 패리티.
+//    (인터리브 XOR: 한 스트라이프당 1개, 연속 손실은 최대 M 개까지 복구)
+//  - 오버헤드는 M / K 로 조절한다. (예: K=16, M=2 -> 12.5%)
+//  - 패리티 payload 구조: [XOR된 데이터 길이(4, little-endian)] + [XOR된 데이터...]
+//    (마지막 청크처럼 길이가 짧은 청크도 길이까지 복원하기 위함)
+// ================================================================
+
+// 패리티 payload 앞에 붙는 길이 필드 크기
+constexpr std::size_t FEC_PARITY_LEN_BYTES = 4;
+
+/**
+ * @brief dst[i] ^= src[i] (0 <= i < n) 를 SIMD 로 수행한다.
+ *
+ * @details
+ *   - SSE2 / NEON 이 있으면 16바이트 단위로 처리하고 나머지는 바이트 단위로 처리한다.
+ */
+void FecXorInto(unsigned char* dst, const unsigned char* src, std::size_t n);
+
+/**
+ * @brief 데이터 청크 개수에 대한 FEC 그룹 개수
+ */
+inline uint64_t FecGroupCount(uint64_t totalPackets, uint32_t k)
+{
+    return (totalPackets + k - 1) / k;
+}
+
+/**
+ * @brief 데이터 청크 index 가 속한 패리티 번호 (0부터, 전체 패리티 중 몇 번째인지)
+ */
+inline uint64_t FecParityOf(uint64_t index, uint32_t k, uint32_t m)
+{
+    return (index / k) * m + (index % k) % m;
+}
+
+#endif // FEC_H
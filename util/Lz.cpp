@@ -0,0 +1,157 @@
+#include "Lz.h"
+
+#include <cstring> // memcpy
+
+namespace {
+
+constexpr std::size_t kMinMatch  = 4;
+constexpr std::size_t kMaxOffset = 65535;
+constexpr int kHashBits = 12;
+
+inline uint32_t Load32(const char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint32_t Hash(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+// 길이가 15 이상이면 255 단위로 이어서 기록
+void WriteLength(std::string& out, std::size_t len)
+{
+    while (len >= 255) {
+        out.push_back(static_cast<char>(255));
+        len -= 255;
+    }
+    out.push_back(static_cast<char>(len));
+}
+
+void WriteSequence(std::string& out, const char* literal, std::size_t litLen,
+                   std::size_t offset, std::size_t matchLen)
+{
+    std::size_t m = matchLen ? matchLen - kMinMatch : 0;
+
+    unsigned char token = static_cast<unsigned char>(
+        ((litLen < 15 ? litLen : 15) << 4) | (m < 15 ? m : 15));
+    out.push_back(static_cast<char>(token));
+
+    if (litLen >= 15) WriteLength(out, litLen - 15);
+    out.append(literal, litLen);
+
+    if (matchLen == 0) return; // 마지막 시퀀스
+
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (m >= 15) WriteLength(out, m - 15);
+}
+
+bool ReadLength(const unsigned char*& ip, const unsigned char* end, std::size_t& len)
+{
+    unsigned char b;
+    do {
+        if (ip >= end) return false;
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+std::size_t LzCompress(const char* src, std::size_t length, std::string& out)
+{
+    out.clear();
+    out.reserve(LZ_HEADER_BYTES + length + length / 255 + 16);
+
+    for (std::size_t b = 0; b < LZ_HEADER_BYTES; ++b)
+        out.push_back(static_cast<char>((length >> (8 * b)) & 0xFF));
+
+    // 위치+1 을 저장 (0은 비어 있음)
+    uint32_t table[1 << kHashBits] = {};
+
+    std::size_t ip = 0;
+    std::size_t anchor = 0;
+    std::size_t misses = 0;
+
+    while (ip + kMinMatch <= length) {
+        uint32_t seq = Load32(src + ip);
+        uint32_t h = Hash(seq);
+        std::size_t ref = table[h];
+        table[h] = static_cast<uint32_t>(ip + 1);
+
+        if (ref != 0 && ip - (ref - 1) <= kMaxOffset && Load32(src + ref - 1) == seq) {
+            std::size_t from = ref - 1;
+            std::size_t matchLen = kMinMatch;
+            while (ip + matchLen < length && src[from + matchLen] == src[ip + matchLen])
+                ++matchLen;
+
+            WriteSequence(out, src + anchor, ip - anchor, ip - from, matchLen);
+            ip += matchLen;
+            anchor = ip;
+            misses = 0;
+        } else {
+            // 매치가 계속 없으면 건너뛰는 폭을 늘려 압축 안 되는 데이터에서 빨리 빠져나간다
+            ip += 1 + (misses++ >> 5);
+        }
+    }
+
+    WriteSequence(out, src + anchor, length - anchor, 0, 0);
+    return out.size();
+}
+
+bool LzReadRawLength(const unsigned char* src, std::size_t length, uint32_t& rawLength)
+{
+    if (length < LZ_HEADER_BYTES) return false;
+
+    rawLength = 0;
+    for (std::size_t b = 0; b < LZ_HEADER_BYTES; ++b)
+        rawLength |= static_cast<uint32_t>(src[b]) << (8 * b);
+    return true;
+}
+
+bool LzDecompress(const unsigned char* src, std::size_t length,
+                  unsigned char* dst, std::size_t dstCap)
+{
+    uint32_t rawLength = 0;
+    if (!LzReadRawLength(src, length, rawLength) || rawLength > dstCap)
+        return false;
+
+    const unsigned char* ip  = src + LZ_HEADER_BYTES;
+    const unsigned char* end = src + length;
+    std::size_t op = 0;
+
+    while (ip < end) {
+        unsigned char token = *ip++;
+
+        // 1) 리터럴 복사
+        std::size_t litLen = token >> 4;
+        if (litLen == 15 && !ReadLength(ip, end, litLen)) return false;
+        if (litLen > static_cast<std::size_t>(end - ip) || op + litLen > rawLength) return false;
+        if (litLen) std::memcpy(dst + op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        if (ip == end) break; // 마지막 시퀀스
+
+        // 2) 매치 복사 (겹칠 수 있으므로 바이트 단위)
+        if (end - ip < 2) return false;
+        std::size_t offset = ip[0] | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+
+        std::size_t matchLen = token & 0x0F;
+        if (matchLen == 15 && !ReadLength(ip, end, matchLen)) return false;
+        matchLen += kMinMatch;
+
+        if (offset == 0 || offset > op || op + matchLen > rawLength) return false;
+        const unsigned char* from = dst + op - offset;
+        for (std::size_t i = 0; i < matchLen; ++i)
+            dst[op + i] = from[i];
+        op += matchLen;
+    }
+
+    return op == rawLength;
+}
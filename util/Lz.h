@@ -0,0 +1,48 @@
+#ifndef LZ_H
+#define LZ_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ================================================================
+//  청크 단위 고속 LZ 압축 코덱 (LZ4 계열의 단순화된 블록 포맷)
+//
+//  포맷: [원본 길이(4, little-endian)] + 시퀀스...
+//  시퀀스: [토큰(상위 4비트 리터럴 길이, 하위 4비트 매치 길이-4)]
+//          [리터럴 길이 확장(255...)] [리터럴...]
+//          [오프셋(2, little-endian)] [매치 길이 확장(255...)]
+//  마지막 시퀀스는 리터럴만 있고 오프셋이 없다.
+//
+//  - 청크마다 독립적으로 압축하므로 재전송 시 임의 청크만 다시 보낼 수 있다.
+// ================================================================
+
+// 압축 스트림 앞의 원본 길이 필드 크기
+constexpr std::size_t LZ_HEADER_BYTES = 4;
+
+/**
+ * @brief src 를 압축해 out 에 기록한다.
+ *
+ * @return 압축 결과 바이트 수 (out.size() 와 같음)
+ */
+std::size_t LzCompress(const char* src, std::size_t length, std::string& out);
+
+/**
+ * @brief 압축 스트림 앞에 기록된 원본 길이를 읽는다.
+ *
+ * @return 성공 시 true (length 가 LZ_HEADER_BYTES 보다 짧으면 false)
+ */
+bool LzReadRawLength(const unsigned char* src, std::size_t length, uint32_t& rawLength);
+
+/**
+ * @brief 압축 스트림을 dst 에 바로 풀어 쓴다.
+ *
+ * @param dst     LzReadRawLength 로 얻은 원본 길이만큼 확보된 버퍼
+ * @param dstCap  dst 크기
+ *
+ * @return 성공 시 true (형식 오류, 범위 초과 시 false)
+ */
+bool LzDecompress(const unsigned char* src, std::size_t length,
+                  unsigned char* dst, std::size_t dstCap);
+
+#endif // LZ_H
@@ -0,0 +1,115 @@
+#include "MemoryBudget.h"
+
+#include <utility>
+
+const char* MemoryCategoryName(MemoryCategory category)
+{
+    switch (category) {
+    case MEM_SEND_BUFFERS: return "send";
+    case MEM_SEND_CACHE:   return "cache";
+    case MEM_RECV_BUFFERS: return "recv";
+    default:               return "unknown";
+    }
+}
+
+// ------------------------------------
+// MemoryBudget
+// ------------------------------------
+
+MemoryBudget& MemoryBudget::Global()
+{
+    static MemoryBudget budget;
+    return budget;
+}
+
+MemoryBudget::MemoryBudget(uint64_t limit)
+    : m_limit(limit), m_used(0), m_peak(0), m_rejected(0), m_byCategory{}
+{
+}
+
+bool MemoryBudget::TryReserve(MemoryCategory category, uint64_t bytes)
+{
+    // 여러 스레드가 동시에 예약해도 합이 한도를 넘지 않도록 CAS 로 올린다
+    uint64_t used = m_used.load(std::memory_order_relaxed);
+    do {
+        if (bytes > Limit() || used > Limit() - bytes) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!m_used.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+    AddUsed(category, bytes, used + bytes);
+    return true;
+}
+
+void MemoryBudget::Reserve(MemoryCategory category, uint64_t bytes)
+{
+    uint64_t used = m_used.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    AddUsed(category, bytes, used);
+}
+
+void MemoryBudget::Release(MemoryCategory category, uint64_t bytes)
+{
+    m_used.fetch_sub(bytes, std::memory_order_relaxed);
+    m_byCategory[category].fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+uint64_t MemoryBudget::Available() const
+{
+    uint64_t used = Used();
+    uint64_t limit = Limit();
+    return used < limit ? limit - used : 0;
+}
+
+void MemoryBudget::AddUsed(MemoryCategory category, uint64_t bytes, uint64_t used)
+{
+    m_byCategory[category].fetch_add(bytes, std::memory_order_relaxed);
+
+    uint64_t peak = m_peak.load(std::memory_order_relaxed);
+    while (used > peak && !m_peak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+    }
+}
+
+// ------------------------------------
+// MemoryReservation
+// ------------------------------------
+
+MemoryReservation::MemoryReservation(MemoryReservation&& other) noexcept
+    : m_budget(other.m_budget), m_category(other.m_category), m_bytes(std::exchange(other.m_bytes, 0))
+{
+}
+
+MemoryReservation& MemoryReservation::operator=(MemoryReservation&& other) noexcept
+{
+    if (this != &other) {
+        Release();
+        m_budget = other.m_budget;
+        m_category = other.m_category;
+        m_bytes = std::exchange(other.m_bytes, 0);
+    }
+    return *this;
+}
+
+bool MemoryReservation::TryGrow(uint64_t bytes)
+{
+    if (!m_budget->TryReserve(m_category, bytes)) {
+        return false;
+    }
+    m_bytes += bytes;
+    return true;
+}
+
+void MemoryReservation::Resize(uint64_t bytes)
+{
+    if (bytes > m_bytes) {
+        m_budget->Reserve(m_category, bytes - m_bytes);
+    } else if (bytes < m_bytes) {
+        m_budget->Release(m_category, m_bytes - bytes);
+    }
+    m_bytes = bytes;
+}
+
+void MemoryReservation::Release()
+{
+    Resize(0);
+}
@@ -0,0 +1,108 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// ================================================================
+//  프로세스 전체 메모리 예산 (청크 버퍼 / 캐시 / 수신 버퍼)
+//
+//  - 큰 버퍼를 잡기 전에 TryReserve 로 예산을 먼저 받는다.
+//    예산을 넘으면 할당하지 않고 호출하는 쪽이 대기/버림을 결정한다.
+//  - 이미 승인된 작업의 실제 크기가 추정과 다르면 Reserve 로 강제로 맞춘다.
+//    (한도를 조금 넘을 수 있지만 새 작업은 그만큼 더 늦게 승인된다)
+//  - 카운터는 atomic 이므로 서버 이벤트 루프와 클라이언트 수신 스레드가 같이 쓴다.
+// ================================================================
+
+enum MemoryCategory {
+    MEM_SEND_BUFFERS = 0, // 전송 중인 분할 청크 (+ FEC 패리티)
+    MEM_SEND_CACHE,       // 구간 요청(FILE_RANGE)용으로 남겨 둔 분할 결과
+    MEM_RECV_BUFFERS,     // 수신 측 청크 버퍼
+    MEM_CATEGORY_COUNT
+};
+
+// 카테고리 이름 (MEM_STATUS 출력용)
+const char* MemoryCategoryName(MemoryCategory category);
+
+class MemoryBudget {
+public:
+    // 한도를 정하지 않았을 때 (1 GiB)
+    static constexpr uint64_t DEFAULT_LIMIT = 1ull << 30;
+
+    // 프로세스에 하나뿐인 예산
+    static MemoryBudget& Global();
+
+    explicit MemoryBudget(uint64_t limit = DEFAULT_LIMIT);
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    // 한도 변경 (이미 잡힌 메모리는 그대로, 이후 TryReserve 부터 적용)
+    void SetLimit(uint64_t limit) { m_limit.store(limit, std::memory_order_relaxed); }
+
+    /**
+     * @brief 한도 안이면 bytes 를 예약한다.
+     * @return 예약했으면 true, 한도를 넘으면 false (아무것도 바꾸지 않음)
+     */
+    bool TryReserve(MemoryCategory category, uint64_t bytes);
+
+    // 한도와 상관없이 예약 (이미 승인된 할당의 크기 보정용)
+    void Reserve(MemoryCategory category, uint64_t bytes);
+
+    void Release(MemoryCategory category, uint64_t bytes);
+
+    uint64_t Limit() const { return m_limit.load(std::memory_order_relaxed); }
+    uint64_t Used() const { return m_used.load(std::memory_order_relaxed); }
+    uint64_t Used(MemoryCategory category) const { return m_byCategory[category].load(std::memory_order_relaxed); }
+    uint64_t Peak() const { return m_peak.load(std::memory_order_relaxed); }
+
+    // 지금 더 예약할 수 있는 바이트 수
+    uint64_t Available() const;
+
+    // TryReserve 가 거절한 횟수
+    uint64_t Rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+
+private:
+    void AddUsed(MemoryCategory category, uint64_t bytes, uint64_t used);
+
+    std::atomic<uint64_t> m_limit;
+    std::atomic<uint64_t> m_used;
+    std::atomic<uint64_t> m_peak;
+    std::atomic<uint64_t> m_rejected;
+    std::atomic<uint64_t> m_byCategory[MEM_CATEGORY_COUNT];
+};
+
+// 예약 하나의 소유권 (소멸할 때 반납, 이동만 가능)
+class MemoryReservation {
+public:
+    explicit MemoryReservation(MemoryCategory category = MEM_SEND_BUFFERS, MemoryBudget& budget = MemoryBudget::Global())
+        : m_budget(&budget), m_category(category)
+    {
+    }
+
+    ~MemoryReservation() { Release(); }
+
+    MemoryReservation(MemoryReservation&& other) noexcept;
+    MemoryReservation& operator=(MemoryReservation&& other) noexcept;
+
+    MemoryReservation(const MemoryReservation&) = delete;
+    MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+    // 한도 안일 때만 bytes 만큼 늘린다
+    bool TryGrow(uint64_t bytes);
+
+    // 예약 크기를 bytes 로 맞춘다 (한도 무시, 승인된 작업의 실제 크기 반영용)
+    void Resize(uint64_t bytes);
+
+    void Release();
+
+    uint64_t Bytes() const { return m_bytes; }
+
+private:
+    MemoryBudget* m_budget;
+    MemoryCategory m_category;
+    uint64_t m_bytes = 0;
+};
+
+#endif // MEMORY_BUDGET_H
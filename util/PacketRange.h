@@ -0,0 +1,77 @@
+#ifndef PACKET_RANGE_H
+#define PACKET_RANGE_H
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief 패킷 번호 구간 [begin, end)
+ *
+ * - 재전송/이어받기 요청에서 빠진 패킷들을 한 줄로 표현하기 위해 사용한다.
+ * - 문자열 형식: "begin-last,begin-last,..." (last 포함, 예: "0-99,150-150")
+ */
+struct PacketRange {
+    uint64_t begin;
+    uint64_t end;
+};
+
+/**
+ * @brief 구간 목록을 "a-b,c-d" 문자열로 변환한다. (빈 목록이면 빈 문자열)
+ */
+inline std::string FormatPacketRanges(const std::vector<PacketRange>& ranges)
+{
+    std::string out;
+    for (const auto& r : ranges) {
+        if (r.end <= r.begin) continue;
+        if (!out.empty()) out.push_back(',');
+        out += std::to_string(r.begin);
+        out.push_back('-');
+        out += std::to_string(r.end - 1);
+    }
+    return out;
+}
+
+/**
+ * @brief "a-b,c,d-e" 문자열을 구간 목록으로 변환한다. (단일 번호 "c" 도 허용)
+ *
+ * @return 형식 오류가 있으면 false (out 은 그때까지 읽은 구간만 담는다)
+ *
+ * @details
+ *   - 각 번호는 10진수 숫자로만 이루어져야 한다. ("-5", "1-2-3", "1x" 는 오류)
+ *   - last 가 UINT64_MAX 인 구간은 [begin, end) 로 표현할 수 없으므로 오류.
+ */
+inline bool ParsePacketRanges(std::string_view text, std::vector<PacketRange>& out)
+{
+    auto parseNumber = [](std::string_view token, uint64_t& value) {
+        auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        return !token.empty() && ec == std::errc() && ptr == token.data() + token.size();
+    };
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t comma = text.find(',', pos);
+        if (comma == std::string_view::npos) comma = text.size();
+
+        std::string_view item = text.substr(pos, comma - pos);
+        std::size_t dash = item.find('-');
+
+        uint64_t first = 0;
+        uint64_t last = 0;
+        if (!parseNumber(item.substr(0, dash), first)) return false;
+        if (dash == std::string_view::npos) {
+            last = first;
+        } else if (!parseNumber(item.substr(dash + 1), last)) {
+            return false;
+        }
+        if (last < first || last == UINT64_MAX) return false;
+        out.push_back({first, last + 1});
+
+        pos = comma + 1;
+    }
+    return true;
+}
+
+#endif // PACKET_RANGE_H
@@ -0,0 +1,54 @@
+#ifndef RTT_ESTIMATOR_H
+#define RTT_ESTIMATOR_H
+
+#include <algorithm>
+#include <cstdint>
+
+// ================================================================
+//  왕복 시간(RTT) 추정과 재전송 타임아웃(RTO) 계산 (RFC 6298)
+//
+//  - SRTT   = 7/8 SRTT + 1/8 sample
+//  - RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - sample|
+//  - RTO    = SRTT + 4 * RTTVAR   (MIN_RTO_US ~ MAX_RTO_US 로 제한)
+//  - 재전송한 패킷의 ACK 는 어느 전송에 대한 것인지 모르므로 표본으로 쓰지 않는다 (Karn)
+// ================================================================
+
+class RttEstimator {
+public:
+    // 단위: 마이크로초
+    static constexpr uint64_t INITIAL_RTO_US = 200 * 1000;
+    static constexpr uint64_t MIN_RTO_US = 5 * 1000;
+    static constexpr uint64_t MAX_RTO_US = 5 * 1000 * 1000;
+
+    void AddSample(uint64_t sampleUs)
+    {
+        if (!m_hasSample) {
+            m_srtt = sampleUs;
+            m_rttvar = sampleUs / 2;
+            m_hasSample = true;
+            return;
+        }
+
+        uint64_t diff = (m_srtt > sampleUs) ? m_srtt - sampleUs : sampleUs - m_srtt;
+        m_rttvar = (3 * m_rttvar + diff) / 4;
+        m_srtt = (7 * m_srtt + sampleUs) / 8;
+    }
+
+    // 재전송 횟수만큼 두 배씩 늘린 타임아웃
+    uint64_t RtoUs(uint32_t backoff = 0) const
+    {
+        uint64_t rto = m_hasSample ? m_srtt + 4 * m_rttvar : INITIAL_RTO_US;
+        rto = std::clamp(rto, MIN_RTO_US, MAX_RTO_US);
+        return std::min(rto << std::min<uint32_t>(backoff, 16), MAX_RTO_US);
+    }
+
+    uint64_t SrttUs() const { return m_hasSample ? m_srtt : INITIAL_RTO_US; }
+    bool HasSample() const { return m_hasSample; }
+
+private:
+    uint64_t m_srtt = 0;
+    uint64_t m_rttvar = 0;
+    bool m_hasSample = false;
+};
+
+#endif // RTT_ESTIMATOR_H
@@ -0,0 +1,169 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel(uint64_t nowTick)
+    : m_nodes(SENTINELS), m_current(nowTick), m_size(0)
+{
+    // 각 칸의 센티널은 자기 자신을 가리키는 빈 원형 리스트
+    for (uint32_t i = 0; i < SENTINELS; ++i) {
+        m_nodes[i].prev = i;
+        m_nodes[i].next = i;
+    }
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(uint64_t expireTick, uint64_t userData)
+{
+    uint32_t index;
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(Node{NIL, NIL, 1, false, 0, 0});
+    }
+
+    Node& node = m_nodes[index];
+    node.expire = expireTick;
+    node.userData = userData;
+    Place(index);
+    ++m_size;
+
+    return (static_cast<uint64_t>(node.generation) << 32) | index;
+}
+
+bool TimerWheel::Cancel(TimerId id)
+{
+    uint32_t index = static_cast<uint32_t>(id);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+    if (index < SENTINELS || index >= m_nodes.size())
+        return false;
+
+    Node& node = m_nodes[index];
+    if (!node.linked || node.generation != generation)
+        return false;
+
+    Unlink(index);
+    Release(index);
+    return true;
+}
+
+void TimerWheel::Advance(uint64_t nowTick, std::vector<uint64_t>& expired)
+{
+    // 타이머가 하나도 없으면 틱을 하나씩 돌 필요가 없다
+    if (m_size == 0) {
+        if (nowTick > m_current)
+            m_current = nowTick;
+        return;
+    }
+
+    // 이미 지난 시각으로 등록된 타이머는 현재 칸에 들어 있으므로 현재 칸부터 처리
+    while (true) {
+        uint32_t slot0 = static_cast<uint32_t>(m_current & SLOT_MASK);
+        uint32_t head = slot0;
+
+        // 1) 현재 칸의 타이머 만료
+        while (m_nodes[head].next != head) {
+            uint32_t index = m_nodes[head].next;
+            Unlink(index);
+            expired.push_back(m_nodes[index].userData);
+            Release(index);
+        }
+
+        if (m_current >= nowTick)
+            break;
+
+        if (m_size == 0) {
+            m_current = nowTick;
+            break;
+        }
+
+        // 2) 한 틱 진행, 0단계가 한 바퀴 돌면 윗단계 칸을 내려 보낸다
+        ++m_current;
+        for (int level = 1; level < LEVELS; ++level) {
+            uint64_t lower = m_current & ((uint64_t(1) << (LEVEL_BITS * level)) - 1);
+            if (lower != 0)
+                break;
+            Cascade(level, static_cast<uint32_t>((m_current >> (LEVEL_BITS * level)) & SLOT_MASK));
+        }
+    }
+}
+
+uint64_t TimerWheel::NextExpiryTick() const
+{
+    if (m_size == 0)
+        return UINT64_MAX;
+
+    // 윗단계 타이머는 0단계가 한 바퀴 돌아 내려오기 전에는 만료되지 않는다
+    uint64_t cascade = (m_current | SLOT_MASK) + 1;
+    for (uint64_t tick = m_current; tick < cascade; ++tick) {
+        uint32_t head = static_cast<uint32_t>(tick & SLOT_MASK);
+        if (m_nodes[head].next != head)
+            return tick;
+    }
+    return cascade;
+}
+
+void TimerWheel::Place(uint32_t index)
+{
+    Node& node = m_nodes[index];
+
+    // 지난 시각이면 현재 칸 (다음 Advance 에서 바로 만료)
+    uint64_t expire = node.expire < m_current ? m_current : node.expire;
+    uint64_t delta = expire - m_current;
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (LEVEL_BITS * (level + 1))))
+        ++level;
+
+    // 휠 범위를 넘는 타이머는 가장 먼 칸에 두고, 내려올 때 다시 배치한다
+    uint64_t maxDelta = (uint64_t(1) << (LEVEL_BITS * LEVELS)) - 1;
+    if (delta > maxDelta)
+        expire = m_current + maxDelta;
+
+    uint32_t slot = static_cast<uint32_t>((expire >> (LEVEL_BITS * level)) & SLOT_MASK);
+    Link(static_cast<uint32_t>(level) * SLOTS + slot, index);
+}
+
+void TimerWheel::Link(uint32_t head, uint32_t index)
+{
+    Node& node = m_nodes[index];
+    node.prev = head;
+    node.next = m_nodes[head].next;
+    m_nodes[node.next].prev = index;
+    m_nodes[head].next = index;
+    node.linked = true;
+}
+
+void TimerWheel::Unlink(uint32_t index)
+{
+    Node& node = m_nodes[index];
+    m_nodes[node.prev].next = node.next;
+    m_nodes[node.next].prev = node.prev;
+    node.prev = node.next = NIL;
+    node.linked = false;
+}
+
+void TimerWheel::Release(uint32_t index)
+{
+    // 세대를 올려서 이전 아이디로 Cancel 해도 새 타이머가 지워지지 않게 한다
+    if (++m_nodes[index].generation == 0)
+        m_nodes[index].generation = 1;
+    m_free.push_back(index);
+    --m_size;
+}
+
+void TimerWheel::Cascade(int level, uint32_t slot)
+{
+    uint32_t head = static_cast<uint32_t>(level) * SLOTS + slot;
+
+    // 리스트를 떼어낸 뒤 하나씩 다시 배치 (대부분 아래 단계로 내려간다)
+    uint32_t index = m_nodes[head].next;
+    m_nodes[head].next = m_nodes[head].prev = head;
+
+    while (index != head) {
+        uint32_t next = m_nodes[index].next;
+        m_nodes[index].linked = false;
+        Place(index);
+        index = next;
+    }
+}
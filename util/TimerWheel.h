@@ -0,0 +1,91 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ================================================================
+//  계층형 타이머 휠 (Varghese & Lauck)
+//
+//  - 4단계 x 256칸, 1틱 단위 (틱 길이는 호출하는 쪽이 정한다. 예: 1ms)
+//  - 등록/취소: O(1) (노드 배열 + 칸마다 이중 연결 리스트)
+//  - 진행: 틱마다 0단계 한 칸을 처리하고, 0단계가 한 바퀴 돌 때마다
+//    윗단계 한 칸의 타이머를 아래 단계로 내려 보낸다.
+//  - 패킷마다 타이머를 걸어도 힙 정렬 비용이 없으므로 수백만 개도 감당한다.
+// ================================================================
+
+class TimerWheel {
+public:
+    // (세대 << 32) | 노드 번호. 0 은 "타이머 없음"
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    explicit TimerWheel(uint64_t nowTick = 0);
+
+    /**
+     * @brief expireTick 에 만료되는 타이머를 등록한다.
+     *
+     * @param expireTick  만료 틱 (이미 지났으면 다음 Advance 에서 바로 만료)
+     * @param userData    만료 시 돌려받을 값
+     * @return 타이머 아이디 (Cancel 에 사용)
+     */
+    TimerId Schedule(uint64_t expireTick, uint64_t userData);
+
+    /**
+     * @brief 타이머를 취소한다.
+     * @return 아직 살아 있던 타이머였으면 true (이미 만료/취소됐으면 false)
+     */
+    bool Cancel(TimerId id);
+
+    /**
+     * @brief nowTick 까지 시간을 진행하고, 만료된 타이머의 userData 를 expired 뒤에 붙인다.
+     */
+    void Advance(uint64_t nowTick, std::vector<uint64_t>& expired);
+
+    uint64_t CurrentTick() const { return m_current; }
+
+    /**
+     * @brief 가장 먼저 만료될 수 있는 틱 (타이머가 없으면 UINT64_MAX)
+     *
+     * 0단계 칸만 훑으므로 윗단계에 있는 타이머는 내려오는 시각(0단계가 한 바퀴 도는 틱)으로 대신한다.
+     * 실제 만료보다 이를 수는 있어도 늦지는 않으므로 잠들 시간을 정하는 데 쓴다.
+     */
+    uint64_t NextExpiryTick() const;
+
+    // 등록되어 있는 타이머 수
+    std::size_t Size() const { return m_size; }
+
+private:
+    static constexpr int LEVEL_BITS = 8;
+    static constexpr int LEVELS = 4;
+    static constexpr uint32_t SLOTS = 1u << LEVEL_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        uint32_t prev;
+        uint32_t next;
+        uint32_t generation;
+        bool     linked;
+        uint64_t expire;
+        uint64_t userData;
+    };
+
+    // 앞쪽 LEVELS * SLOTS 개 노드는 각 칸의 리스트 머리 (센티널)
+    static constexpr uint32_t SENTINELS = LEVELS * SLOTS;
+
+    void Place(uint32_t index);
+    void Link(uint32_t head, uint32_t index);
+    void Unlink(uint32_t index);
+    void Release(uint32_t index);
+    // level 의 slot 칸에 있는 타이머를 모두 다시 배치한다
+    void Cascade(int level, uint32_t slot);
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_free;
+    uint64_t m_current;
+    std::size_t m_size;
+};
+
+#endif // TIMER_WHEEL_H
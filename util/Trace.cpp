@@ -0,0 +1,150 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceRecord {
+    const char* name;
+    uint64_t startNs;
+    uint64_t durNs;
+    uint64_t arg;
+    char phase;
+};
+
+// 스레드 하나가 쓰고, 덤프 때만 다른 스레드가 읽는 링 버퍼
+struct TraceRing {
+    static constexpr std::size_t CAPACITY = 1 << 16;
+    static constexpr std::size_t MASK = CAPACITY - 1;
+
+    explicit TraceRing(uint32_t threadIndex)
+        : records(new TraceRecord[CAPACITY]), head(0), tid(threadIndex)
+    {
+    }
+
+    std::unique_ptr<TraceRecord[]> records;
+    std::atomic<uint64_t> head;  // 지금까지 기록한 이벤트 수
+    uint32_t tid;
+};
+
+// 링 버퍼 목록 (스레드가 끝나도 덤프할 수 있도록 여기서 소유)
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+};
+
+TraceRegistry& Registry()
+{
+    static TraceRegistry registry;
+    return registry;
+}
+
+const std::chrono::steady_clock::time_point TRACE_EPOCH = std::chrono::steady_clock::now();
+
+TraceRing& ThreadRing()
+{
+    // 스레드마다 처음 기록할 때 한 번만 잠금을 잡고 등록한다
+    thread_local TraceRing* ring = [] {
+        TraceRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.rings.push_back(std::make_unique<TraceRing>(static_cast<uint32_t>(registry.rings.size() + 1)));
+        return registry.rings.back().get();
+    }();
+    return *ring;
+}
+
+void WriteJsonString(std::ofstream& out, const char* text)
+{
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') out << '\\';
+        out << *p;
+    }
+    out << '"';
+}
+
+// ns 값을 소수점 3자리 us 로 출력 (Chrome trace 의 ts / dur 단위)
+void WriteMicros(std::ofstream& out, uint64_t ns)
+{
+    char frac[4] = {
+        static_cast<char>('0' + ns / 100 % 10),
+        static_cast<char>('0' + ns / 10 % 10),
+        static_cast<char>('0' + ns % 10),
+        '\0',
+    };
+    out << ns / 1000 << '.' << frac;
+}
+
+} // namespace
+
+uint64_t TraceNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - TRACE_EPOCH).count();
+}
+
+void TraceEmit(const char* name, char phase, uint64_t startNs, uint64_t durNs, uint64_t arg)
+{
+    TraceRing& ring = ThreadRing();
+
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.records[head & TraceRing::MASK] = TraceRecord{name, startNs, durNs, arg, phase};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+int64_t TraceDumpChrome(const std::string& path)
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return -1;
+    }
+
+    TraceRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    int64_t written = 0;
+    std::vector<TraceRecord> copy;
+    for (const auto& ring : registry.rings) {
+        // 1. 현재 남아 있는 구간을 복사
+        uint64_t end = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = end > TraceRing::CAPACITY ? end - TraceRing::CAPACITY : 0;
+
+        copy.clear();
+        for (uint64_t i = begin; i < end; ++i) {
+            copy.push_back(ring->records[i & TraceRing::MASK]);
+        }
+
+        // 2. 복사하는 동안 기록이 계속됐으면 덮어쓰였을 수 있는 앞부분을 버린다
+        //    (기록 중일 수 있는 after 번 칸은 after - CAPACITY 번과 같은 칸이므로 그것까지 버림)
+        uint64_t after = ring->head.load(std::memory_order_acquire);
+        uint64_t safeBegin = after + 1 > TraceRing::CAPACITY ? after + 1 - TraceRing::CAPACITY : 0;
+        std::size_t skip = safeBegin > begin ? static_cast<std::size_t>(std::min(safeBegin - begin, end - begin)) : 0;
+
+        // 3. Chrome trace 이벤트로 출력 (ts / dur 는 us 단위 실수)
+        for (std::size_t i = skip; i < copy.size(); ++i) {
+            const TraceRecord& r = copy[i];
+            out << (written == 0 ? "\n" : ",\n") << "{\"name\":";
+            WriteJsonString(out, r.name);
+            out << ",\"ph\":\"" << r.phase << "\",\"ts\":";
+            WriteMicros(out, r.startNs);
+            if (r.phase == 'X') {
+                out << ",\"dur\":";
+                WriteMicros(out, r.durNs);
+            } else {
+                out << ",\"s\":\"t\"";
+            }
+            out << ",\"pid\":1,\"tid\":" << ring->tid << ",\"args\":{\"v\":" << r.arg << "}}";
+            ++written;
+        }
+    }
+
+    out << "\n]}\n";
+    return out ? written : -1;
+}
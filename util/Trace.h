@@ -0,0 +1,83 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+
+// ================================================================
+//  패킷 수명 주기 추적 (Chrome / Perfetto trace JSON 으로 내보내기)
+//
+//  - 컴파일 스위치: -DUDPTCP_TRACE=1 일 때만 TRACE_* 매크로가 기록한다.
+//    꺼져 있으면 매크로가 빈 문장이 되고 인자도 평가하지 않는다.
+//  - 스레드마다 고정 크기 링 버퍼 하나 (잠금 없음, 가득 차면 오래된 것부터 덮어씀)
+//    기록 비용: 시계 읽기 + 레코드 하나 쓰기 + release store 한 번
+//  - 이벤트 이름은 문자열 리터럴이어야 한다. (포인터만 저장)
+// ================================================================
+
+#ifndef UDPTCP_TRACE
+#define UDPTCP_TRACE 0
+#endif
+
+constexpr bool TRACE_ENABLED = UDPTCP_TRACE != 0;
+
+// 추적용 단조 시계 (ns)
+uint64_t TraceNowNs();
+
+/**
+ * @brief 현재 스레드의 링 버퍼에 이벤트 하나를 기록한다.
+ *
+ * @param name     이벤트 이름 (문자열 리터럴)
+ * @param phase    'X' = 구간 (startNs ~ startNs + durNs), 'i' = 순간
+ * @param startNs  시작 시각 (TraceNowNs)
+ * @param durNs    구간 길이 ('i' 면 0)
+ * @param arg      이벤트별 값 (패킷 번호, 바이트 수 등)
+ */
+void TraceEmit(const char* name, char phase, uint64_t startNs, uint64_t durNs, uint64_t arg);
+
+/**
+ * @brief 모든 스레드의 링 버퍼를 Chrome trace JSON 파일로 저장한다.
+ *
+ * @details
+ *   - chrome://tracing 또는 ui.perfetto.dev 에서 바로 열 수 있다.
+ *   - 기록 중에도 호출할 수 있다. (복사하는 동안 덮어쓰인 레코드는 버린다)
+ *
+ * @return 저장한 이벤트 수, 파일을 열 수 없으면 -1
+ */
+int64_t TraceDumpChrome(const std::string& path);
+
+// 생성 ~ 소멸 구간을 'X' 이벤트 하나로 기록
+class TraceScope {
+public:
+    TraceScope(const char* name, uint64_t arg)
+        : m_name(name), m_arg(arg), m_start(TraceNowNs())
+    {
+    }
+
+    ~TraceScope()
+    {
+        TraceEmit(m_name, 'X', m_start, TraceNowNs() - m_start, m_arg);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_arg;
+    uint64_t m_start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if UDPTCP_TRACE
+// 현재 블록이 끝날 때까지를 구간 이벤트로 기록
+#define TRACE_SCOPE(name, arg) TraceScope TRACE_CONCAT(traceScope_, __LINE__)((name), static_cast<uint64_t>(arg))
+// 순간 이벤트 기록
+#define TRACE_INSTANT(name, arg) TraceEmit((name), 'i', TraceNowNs(), 0, static_cast<uint64_t>(arg))
+#else
+#define TRACE_SCOPE(name, arg) ((void)0)
+#define TRACE_INSTANT(name, arg) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,122 @@
+#ifndef WIRE_CODEC_H
+#define WIRE_CODEC_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// ================================================================
+//  필드 목록 하나로 만드는 big-endian 직렬화 코덱
+//
+//  - WireCodec<&S::a, &S::b, ...> 처럼 멤버 포인터를 와이어 순서대로 나열하면
+//    각 필드의 오프셋/전체 크기가 컴파일 시간에 계산되고
+//    Encode / Decode 는 필드마다 memcpy + 바이트 스왑 한 번으로 펼쳐진다. (분기 없음)
+//  - 와이어는 항상 big-endian, 정렬되지 않은 버퍼에서도 안전하다.
+//    (구조체를 reinterpret_cast 하는 방식은 정렬/호스트 엔디언에 묶인다)
+// ================================================================
+
+namespace wire {
+
+// 멤버 포인터에서 구조체 / 필드 타입 꺼내기
+template <typename T>
+struct MemberTraits;
+
+template <typename C, typename T>
+struct MemberTraits<T C::*> {
+    using Class = C;
+    using Type = T;
+};
+
+template <typename T>
+constexpr T ByteSwap(T value)
+{
+    static_assert(std::is_unsigned_v<T>, "wire fields must be unsigned integers");
+
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else if constexpr (sizeof(T) == 2) {
+        return static_cast<T>(__builtin_bswap16(value));
+    } else if constexpr (sizeof(T) == 4) {
+        return static_cast<T>(__builtin_bswap32(value));
+    } else {
+        static_assert(sizeof(T) == 8, "unsupported field width");
+        return static_cast<T>(__builtin_bswap64(value));
+    }
+}
+
+// out 에 value 를 big-endian 으로 기록
+template <typename T>
+inline void StoreBE(unsigned char* out, T value)
+{
+    if constexpr (std::endian::native == std::endian::little)
+        value = ByteSwap(value);
+    std::memcpy(out, &value, sizeof(T));
+}
+
+// in 에서 big-endian 값을 읽음
+template <typename T>
+inline T LoadBE(const unsigned char* in)
+{
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    if constexpr (std::endian::native == std::endian::little)
+        value = ByteSwap(value);
+    return value;
+}
+
+} // namespace wire
+
+template <auto... Members>
+class WireCodec {
+public:
+    using Struct = typename wire::MemberTraits<decltype((Members, ...))>::Class;
+
+    static constexpr std::size_t COUNT = sizeof...(Members);
+
+    // 필드별 바이트 수 (와이어 순서)
+    static constexpr std::array<std::size_t, COUNT> SIZES = {
+        sizeof(typename wire::MemberTraits<decltype(Members)>::Type)...
+    };
+
+    // 필드별 시작 오프셋, 마지막 원소는 전체 크기
+    static constexpr std::array<std::size_t, COUNT + 1> OFFSETS = [] {
+        std::array<std::size_t, COUNT + 1> offsets{};
+        for (std::size_t i = 0; i < COUNT; ++i)
+            offsets[i + 1] = offsets[i] + SIZES[i];
+        return offsets;
+    }();
+
+    // 인코딩된 전체 바이트 수
+    static constexpr std::size_t SIZE = OFFSETS[COUNT];
+
+    // value 를 out[0, SIZE) 에 기록
+    static void Encode(const Struct& value, unsigned char* out)
+    {
+        EncodeFields(value, out, std::make_index_sequence<COUNT>{});
+    }
+
+    // in[0, SIZE) 를 value 로 읽음 (값 검증은 호출하는 쪽에서)
+    static void Decode(const unsigned char* in, Struct& value)
+    {
+        DecodeFields(in, value, std::make_index_sequence<COUNT>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static void EncodeFields(const Struct& value, unsigned char* out, std::index_sequence<I...>)
+    {
+        (wire::StoreBE(out + OFFSETS[I], value.*Members), ...);
+    }
+
+    template <std::size_t... I>
+    static void DecodeFields(const unsigned char* in, Struct& value, std::index_sequence<I...>)
+    {
+        ((value.*Members = wire::LoadBE<typename wire::MemberTraits<decltype(Members)>::Type>(in + OFFSETS[I])), ...);
+    }
+};
+
+#endif // WIRE_CODEC_H
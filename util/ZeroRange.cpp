@@ -0,0 +1,81 @@
+#include "ZeroRange.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h> // _mm_or_si128, _mm_cmpeq_epi8, _mm_movemask_epi8
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>  // vorrq_u8, vmaxvq_u8
+#endif
+
+namespace {
+
+void Put32(std::string& out, uint32_t v)
+{
+    for (int b = 0; b < 4; ++b)
+        out.push_back(static_cast<char>((v >> (8 * b)) & 0xFF));
+}
+
+uint32_t Get32(const unsigned char* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+const unsigned char g_zeroBuffer[ZERO_BUFFER_BYTES] = {};
+
+} // namespace
+
+std::string EncodeZeroRange(const ZeroRange& range)
+{
+    std::string out;
+    out.reserve(ZERO_RANGE_MARKER_BYTES);
+    Put32(out, range.count);
+    Put32(out, range.chunkLength);
+    Put32(out, range.lastLength);
+    return out;
+}
+
+bool DecodeZeroRange(const unsigned char* data, std::size_t length, ZeroRange& out)
+{
+    if (length != ZERO_RANGE_MARKER_BYTES)
+        return false;
+
+    out.count       = Get32(data);
+    out.chunkLength = Get32(data + 4);
+    out.lastLength  = Get32(data + 8);
+    return out.count > 0 && out.lastLength > 0 && out.lastLength <= out.chunkLength;
+}
+
+bool IsAllZero(const void* data, std::size_t length)
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 64 <= length; i += 64) {
+        __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16)));
+        __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 32)),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 48)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(a, b), zero)) != 0xFFFF)
+            return false;
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 64 <= length; i += 64) {
+        uint8x16_t a = vorrq_u8(vld1q_u8(p + i), vld1q_u8(p + i + 16));
+        uint8x16_t b = vorrq_u8(vld1q_u8(p + i + 32), vld1q_u8(p + i + 48));
+        if (vmaxvq_u8(vorrq_u8(a, b)) != 0)
+            return false;
+    }
+#endif
+
+    // 남은 바이트
+    for (; i < length; ++i)
+        if (p[i] != 0)
+            return false;
+    return true;
+}
+
+const unsigned char* ZeroBuffer()
+{
+    return g_zeroBuffer;
+}
@@ -0,0 +1,54 @@
+#ifndef ZERO_RANGE_H
+#define ZERO_RANGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ================================================================
+//  0으로만 채워진 청크(희소 파일의 구멍 포함)를 데이터 대신 보내는 구간 표식
+//
+//  payload 구조 (little-endian):
+//    [count(4)][chunkLength(4)][lastLength(4)]
+//  -> packet_index 부터 count 개의 청크가 모두 0.
+//     마지막 청크만 lastLength, 나머지는 chunkLength 바이트.
+// ================================================================
+
+constexpr std::size_t ZERO_RANGE_MARKER_BYTES = 12;
+
+struct ZeroRange {
+    uint32_t count;
+    uint32_t chunkLength;
+    uint32_t lastLength;
+};
+
+/**
+ * @brief 구간 표식을 payload 문자열로 만든다.
+ */
+std::string EncodeZeroRange(const ZeroRange& range);
+
+/**
+ * @brief payload 에서 구간 표식을 읽는다. (형식이 맞지 않으면 false)
+ */
+bool DecodeZeroRange(const unsigned char* data, std::size_t length, ZeroRange& out);
+
+/**
+ * @brief 구간 안의 index 번째(0부터) 청크 길이
+ */
+inline uint32_t ZeroRangeChunkLength(const ZeroRange& range, uint32_t index)
+{
+    return (index + 1 == range.count) ? range.lastLength : range.chunkLength;
+}
+
+/**
+ * @brief 버퍼가 전부 0인지 검사한다. (SSE2/NEON 으로 64바이트씩 검사, 0이 아닌 값을 만나면 바로 종료)
+ */
+bool IsAllZero(const void* data, std::size_t length);
+
+/**
+ * @brief 0으로 채워진 읽기 전용 버퍼 (다이제스트 계산 등에 재사용, ZERO_BUFFER_BYTES 크기)
+ */
+const unsigned char* ZeroBuffer();
+constexpr std::size_t ZERO_BUFFER_BYTES = 64 * 1024;
+
+#endif // ZERO_RANGE_H